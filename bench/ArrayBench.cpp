@@ -0,0 +1,82 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Appending n elements: ArrayBuilder PushBack with amortized growth against growing an Array to exactly Size() + 1 per
+// append, which is all an Array can do without a capacity. n is 10, 1k and 100k.
+
+#include <type_traits>
+
+#include "PlanetKit.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    template <typename T>
+    void BenchAppend(const char* szType, const T& value, size_t nElements) {
+        size_t nRuns = Iterations(20000000) / nElements + 1;
+
+        char szCase[64];
+        snprintf(szCase, sizeof(szCase), "%s ArrayBuilder PushBack x%zu", szType, nElements);
+        SResult sResult = Measure(nRuns, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                ArrayBuilder<T> builder;
+                for (size_t k = 0; k < nElements; ++k) {
+                    builder.PushBack(value);
+                }
+                Array<T> arr = builder.TakeArray();
+                DoNotOptimize(arr);
+            }
+        });
+        sResult.dNsPerOp /= nElements;
+        sResult.dAllocationsPerOp /= nElements;
+        Report("ArrayAppend", szCase, sResult);
+
+        // Exact growth is quadratic. At 100k it takes seconds for int and about a minute for WString, so it is left out of
+        // quick runs and measured for int only.
+        if (nElements >= 100000 && (QuickMode() || std::is_trivially_copyable<T>::value == false)) {
+            return;
+        }
+
+        snprintf(szCase, sizeof(szCase), "%s Array exact growth x%zu", szType, nElements);
+        sResult = Measure(nElements >= 100000 ? 1 : nRuns, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                Array<T> arr;
+                for (size_t k = 0; k < nElements; ++k) {
+                    arr.Resize(arr.Size() + 1);
+                    arr[arr.Size() - 1] = value;
+                }
+                DoNotOptimize(arr);
+            }
+        });
+        sResult.dNsPerOp /= nElements;
+        sResult.dAllocationsPerOp /= nElements;
+        Report("ArrayAppend", szCase, sResult);
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    const size_t elementCounts[] = { 10, 1000, 100000 };
+    for (size_t nElements : elementCounts) {
+        BenchAppend<int>("int", 42, nElements);
+        BenchAppend<WString>("WString", WString(L"subgroup"), nElements);
+    }
+
+    return 0;
+}
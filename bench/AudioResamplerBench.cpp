@@ -0,0 +1,143 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// AudioResampler quality and cost: THD+N of a 1 kHz sine through common and approximated ratios, and of a tone at 0.4 times
+// the output rate for downsampling, where the stretched filter's transition band is closest. Also CPU time per second of
+// audio per channel for 10 ms blocks.
+
+#include <math.h>
+
+#include "PlanetKitAudioResampler.hpp"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    const double kPi = 3.14159265358979323846;
+
+    /**
+     * Resamples one second of a sine of dToneHz and returns the energy that is not the tone, relative to the tone, in dB.
+     */
+    double MeasureThdN(unsigned int unInputRate, unsigned int unOutputRate, double dToneHz) {
+        SAudioResamplerConfig sConfig;
+        sConfig.unInputSamplingRate = unInputRate;
+        sConfig.unOutputSamplingRate = unOutputRate;
+        AudioResampler resampler(sConfig);
+
+        size_t nInputFrames = unInputRate;
+        float* pInput = new float[nInputFrames];
+        for (size_t i = 0; i < nInputFrames; ++i) {
+            pInput[i] = (float)(0.5 * sin(2 * kPi * dToneHz * i / unInputRate));
+        }
+
+        size_t nCapacity = resampler.GetMaxOutputFrames(nInputFrames);
+        float* pOutput = new float[nCapacity];
+        size_t nOutputFrames = 0;
+        resampler.Process(pInput, nInputFrames, pOutput, nCapacity, nOutputFrames);
+
+        // Skips the filter's warm-up, then fits the tone by least squares over a whole number of periods.
+        size_t nSkip = (size_t)(resampler.GetLatencyInputFrames() * unOutputRate / unInputRate) * 2 + 64;
+        size_t nPeriods = (size_t)((nOutputFrames - nSkip) * dToneHz / unOutputRate);
+        size_t nCount = (size_t)(nPeriods * unOutputRate / dToneHz);
+        double dSin = 0;
+        double dCos = 0;
+        for (size_t i = 0; i < nCount; ++i) {
+            double dAngle = 2 * kPi * dToneHz * (double)(nSkip + i) / unOutputRate;
+            dSin += pOutput[nSkip + i] * sin(dAngle);
+            dCos += pOutput[nSkip + i] * cos(dAngle);
+        }
+        dSin *= 2.0 / nCount;
+        dCos *= 2.0 / nCount;
+
+        double dSignal = 0;
+        double dResidual = 0;
+        for (size_t i = 0; i < nCount; ++i) {
+            double dAngle = 2 * kPi * dToneHz * (double)(nSkip + i) / unOutputRate;
+            double dTone = dSin * sin(dAngle) + dCos * cos(dAngle);
+            dSignal += dTone * dTone;
+            dResidual += (pOutput[nSkip + i] - dTone) * (pOutput[nSkip + i] - dTone);
+        }
+
+        delete[] pOutput;
+        delete[] pInput;
+        return 10 * log10(dResidual / dSignal);
+    }
+
+    void ReportThdN(unsigned int unInputRate, unsigned int unOutputRate, double dToneHz = 1000.0) {
+        char szName[96];
+        snprintf(szName, sizeof(szName), "THD+N %u -> %u, %.0f Hz", unInputRate, unOutputRate, dToneHz);
+        ReportValue("AudioResampler", szName, MeasureThdN(unInputRate, unOutputRate, dToneHz), "dB");
+    }
+
+    void ReportCost(unsigned int unInputRate, unsigned int unOutputRate, unsigned int unChannels) {
+        SAudioResamplerConfig sConfig;
+        sConfig.unInputSamplingRate = unInputRate;
+        sConfig.unOutputSamplingRate = unOutputRate;
+        sConfig.unChannels = unChannels;
+        AudioResampler resampler(sConfig);
+
+        size_t nInputFrames = unInputRate / 100;
+        size_t nCapacity = resampler.GetMaxOutputFrames(nInputFrames);
+        float* pInput = new float[nInputFrames * unChannels];
+        float* pOutput = new float[nCapacity * unChannels];
+        for (size_t i = 0; i < nInputFrames * unChannels; ++i) {
+            pInput[i] = (float)(0.5 * sin(0.01 * i));
+        }
+
+        SResult sResult = Measure(Iterations(200000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                size_t nOutputFrames = 0;
+                resampler.Process(pInput, nInputFrames, pOutput, nCapacity, nOutputFrames);
+                DoNotOptimize(pOutput[0]);
+            }
+        });
+
+        char szName[96];
+        snprintf(szName, sizeof(szName), "%u -> %u x %u ch, 10 ms", unInputRate, unOutputRate, unChannels);
+        Report("AudioResampler", szName, sResult);
+
+        // 100 blocks of 10 ms make a second.
+        snprintf(szName, sizeof(szName), "%u -> %u x %u ch per channel", unInputRate, unOutputRate, unChannels);
+        ReportValue("AudioResampler", szName, sResult.dNsPerOp * 100 / unChannels / 1000.0, "us of CPU per second");
+
+        delete[] pOutput;
+        delete[] pInput;
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    ReportThdN(44100, 48000);
+    ReportThdN(48000, 44100);
+    ReportThdN(48000, 16000);
+    ReportThdN(16000, 48000);
+    // Downsampling near the output Nyquist frequency, 2.5 output samples per period.
+    ReportThdN(48000, 44100, 0.4 * 44100);
+    ReportThdN(48000, 16000, 0.4 * 16000);
+    // Reduce to more than PLNK_AUDIO_RESAMPLER_MAX_PHASES phases, as clock drift compensation does.
+    ReportThdN(48000, 47999);
+    ReportThdN(44100, 48001);
+
+    const unsigned int unChannels[] = { 1, 2, 8 };
+    for (unsigned int unCount : unChannels) {
+        ReportCost(44100, 48000, unCount);
+        ReportCost(48000, 16000, unCount);
+        ReportCost(48000, 47999, unCount);
+    }
+    return 0;
+}
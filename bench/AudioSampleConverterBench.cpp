@@ -0,0 +1,126 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// AudioSampleConverter throughput per SIMD level, in ns per 10 ms stereo frame at 48 kHz and in million samples per second
+// on one core.
+
+#include <math.h>
+
+#include "PlanetKitAudioSampleConverter.hpp"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    const size_t kFrames = 480;
+    const size_t kSamples = kFrames * 2;
+
+    const char* LevelName(EAudioSimdLevel eLevel) {
+        switch (eLevel) {
+        case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+            return "sse2";
+        case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+            return "avx2";
+        case PLNK_AUDIO_SIMD_LEVEL_NEON:
+            return "neon";
+        default:
+            return "scalar";
+        }
+    }
+
+    void ReportThroughput(const char* szKernel, EAudioSimdLevel eLevel, const SResult& sResult) {
+        char szName[96];
+        snprintf(szName, sizeof(szName), "%s %s", szKernel, LevelName(eLevel));
+        Report("AudioSampleConverter", szName, sResult);
+
+        snprintf(szName, sizeof(szName), "%s %s throughput", szKernel, LevelName(eLevel));
+        ReportValue("AudioSampleConverter", szName, kSamples / sResult.dNsPerOp * 1000.0, "Msamples/s/core");
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    float* pFloat = new float[kSamples];
+    float* pLeft = new float[kFrames];
+    float* pRight = new float[kFrames];
+    int16_t* pShort = new int16_t[kSamples];
+    for (size_t i = 0; i < kSamples; ++i) {
+        pFloat[i] = 0.9f * sinf((float)i * 0.01f);
+    }
+    for (size_t i = 0; i < kFrames; ++i) {
+        pLeft[i] = pFloat[i * 2];
+        pRight[i] = pFloat[i * 2 + 1];
+    }
+    const float* ppChannels[2] = { pLeft, pRight };
+
+    const EAudioSimdLevel eLevels[] = { PLNK_AUDIO_SIMD_LEVEL_SCALAR, PLNK_AUDIO_SIMD_LEVEL_SSE2, PLNK_AUDIO_SIMD_LEVEL_AVX2, PLNK_AUDIO_SIMD_LEVEL_NEON };
+    for (EAudioSimdLevel eLevel : eLevels) {
+        if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+            continue;
+        }
+
+        SResult sResult = Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AudioSampleConverter::FloatToInt16(pFloat, pShort, kSamples);
+                DoNotOptimize(pShort[0]);
+            }
+        });
+        ReportThroughput("FloatToInt16", eLevel, sResult);
+
+        SAudioDitherState sDither;
+        sResult = Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AudioSampleConverter::FloatToInt16Dithered(pFloat, pShort, kSamples, sDither);
+                DoNotOptimize(pShort[0]);
+            }
+        });
+        ReportThroughput("FloatToInt16Dithered", eLevel, sResult);
+
+        sResult = Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AudioSampleConverter::Int16ToFloat(pShort, pFloat, kSamples);
+                DoNotOptimize(pFloat[0]);
+            }
+        });
+        ReportThroughput("Int16ToFloat", eLevel, sResult);
+
+        sResult = Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                // Alternates exact powers of two so the samples neither drift nor let the multiply be folded away.
+                AudioSampleConverter::ApplyGain(pFloat, kSamples, (i & 1) ? 2.0f : 0.5f);
+                DoNotOptimize(pFloat[0]);
+            }
+        });
+        ReportThroughput("ApplyGain float", eLevel, sResult);
+
+        sResult = Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AudioSampleConverter::Interleave(ppChannels, 2, kFrames, pFloat);
+                DoNotOptimize(pFloat[0]);
+            }
+        });
+        ReportThroughput("Interleave stereo", eLevel, sResult);
+    }
+    AudioSampleConverter::SetSimdLevel(AudioSampleConverter::GetSupportedSimdLevel());
+
+    delete[] pShort;
+    delete[] pRight;
+    delete[] pLeft;
+    delete[] pFloat;
+    return 0;
+}
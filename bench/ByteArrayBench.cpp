@@ -0,0 +1,111 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Filling a 4 MB ByteArray, as DataSessionFrame::GetBuffer and SharedContents::GetData payloads are: element-wise copy
+// after a value-initializing Resize against Resize + memcpy, ResizeUninitialized + memcpy, Assign, and a plain memcpy.
+// The Resize cases and "Assign into a new array" allocate the destination every time; Assign and plain memcpy reuse it.
+
+#include <string.h>
+
+#include "PlanetKit.h"
+#include "PlanetKitCommonTypes.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    const size_t kBytes = 4 * 1024 * 1024;
+
+    void ReportFill(const char* szCase, const SResult& sResult) {
+        Report("ByteArray 4 MB", szCase, sResult);
+
+        char szName[96];
+        snprintf(szName, sizeof(szName), "%s throughput", szCase);
+        ReportValue("ByteArray 4 MB", szName, kBytes / sResult.dNsPerOp, "GB/s");
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    unsigned char* pSource = new unsigned char[kBytes];
+    for (size_t i = 0; i < kBytes; ++i) {
+        pSource[i] = (unsigned char)(i * 31);
+    }
+
+    ByteArray arr;
+    size_t nIterations = QuickMode() ? 2 : 500;
+
+    ReportFill("Resize + SetAt per element", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            arr.Clear();
+            arr.Resize(kBytes);
+            for (size_t k = 0; k < kBytes; ++k) {
+                arr.SetAt(k, pSource[k]);
+            }
+            DoNotOptimize(arr);
+        }
+    }));
+
+    ReportFill("Resize + memcpy", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            arr.Clear();
+            arr.Resize(kBytes);
+            memcpy(arr.Buffer(), pSource, kBytes);
+            DoNotOptimize(arr);
+        }
+    }));
+
+    ReportFill("ResizeUninitialized + memcpy", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            arr.Clear();
+            arr.ResizeUninitialized(kBytes);
+            memcpy(arr.Buffer(), pSource, kBytes);
+            DoNotOptimize(arr);
+        }
+    }));
+
+    // Assign reuses the buffer of an array that already holds as many elements.
+    arr.Resize(kBytes);
+    ReportFill("Assign", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            arr.Assign(pSource, kBytes);
+            DoNotOptimize(arr);
+        }
+    }));
+
+    unsigned char* pDestination = new unsigned char[kBytes];
+    ReportFill("plain memcpy", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            memcpy(pDestination, pSource, kBytes);
+            DoNotOptimize(pDestination[0]);
+        }
+    }));
+
+    // A fresh array per payload also pays for the allocation and its page faults.
+    ReportFill("Assign into a new array", Measure(nIterations, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            ByteArray fresh;
+            fresh.Assign(pSource, kBytes);
+            DoNotOptimize(fresh);
+        }
+    }));
+
+    delete[] pDestination;
+    delete[] pSource;
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Copy against move for the value types that go through the event callbacks: SharedPtr, AutoPtr, String, WString,
+// WStringOptional and a 200-peer Array of SharedPtr. A move is measured there and back, so the source stays usable.
+
+#include <atomic>
+#include <utility>
+
+#include "PlanetKit.h"
+#include "PlanetKitCommonTypes.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    // Counts atomically, as the InterlockedIncrement of the SDK objects behind AutoPtr does.
+    struct SRefCounted {
+        ULONG AddRef() {
+            return m_ulRefCount.fetch_add(1) + 1;
+        }
+
+        ULONG Release() {
+            return m_ulRefCount.fetch_sub(1) - 1;
+        }
+
+        std::atomic<ULONG> m_ulRefCount{ 1 };
+    };
+
+    struct SPayload {
+        int nValue = 0;
+    };
+
+    template <typename T>
+    void BenchCopyAndMove(const char* szGroup, T& source, size_t nIterations) {
+        Report(szGroup, "copy", Measure(nIterations, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                T copy(source);
+                DoNotOptimize(copy);
+            }
+        }));
+
+        Report(szGroup, "move and move back", Measure(nIterations, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                T moved(std::move(source));
+                DoNotOptimize(moved);
+                source = std::move(moved);
+            }
+        }));
+    }
+
+    void BenchArray() {
+        // Array has no copy constructor, so a copy is what an application writes instead: Assign from the buffer.
+        ArrayBuilder<SharedPtr<SPayload>> builder;
+        for (int i = 0; i < 200; ++i) {
+            builder.PushBack(MakeAutoPtr<SPayload>());
+        }
+        Array<SharedPtr<SPayload>> source = builder.TakeArray();
+
+        Report("Array<SharedPtr> x200", "copy", Measure(Iterations(200000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                Array<SharedPtr<SPayload>> copy;
+                copy.Assign(source.Buffer(), source.Size());
+                DoNotOptimize(copy);
+            }
+        }));
+
+        Report("Array<SharedPtr> x200", "move and move back", Measure(Iterations(20000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                Array<SharedPtr<SPayload>> moved(std::move(source));
+                DoNotOptimize(moved);
+                source = std::move(moved);
+            }
+        }));
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    SharedPtr<SPayload> ptrShared = MakeAutoPtr<SPayload>();
+    BenchCopyAndMove("SharedPtr", ptrShared, Iterations(20000000));
+
+    SRefCounted object;
+    AutoPtr<SRefCounted> ptrAuto(&object);
+    BenchCopyAndMove("AutoPtr", ptrAuto, Iterations(20000000));
+
+    String str("a-service-id-that-does-not-fit-in-any-small-buffer");
+    BenchCopyAndMove("String", str, Iterations(5000000));
+
+    WString wstr(L"a-service-id-that-does-not-fit-in-any-small-buffer");
+    BenchCopyAndMove("WString", wstr, Iterations(5000000));
+
+    WStringOptional strSubgroup(WString(L"breakout-room"));
+    BenchCopyAndMove("WStringOptional", strSubgroup, Iterations(5000000));
+
+    BenchArray();
+    return 0;
+}
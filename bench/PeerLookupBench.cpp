@@ -0,0 +1,121 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Per-frame peer lookup: HashMap<UserIdPtr, V> against a linear scan of a peer array comparing user IDs, for 8 to 500 peers.
+// PlanetKitPeer.h needs the Windows headers, so the peers here only implement the GetUserID() call that a scan makes.
+
+#include "PlanetKit.h"
+#include "PlanetKitUserId.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    class BenchUserId : public UserId {
+    public:
+        BenchUserId(const WString& strID, const WString& strServiceID) : m_strID(strID), m_strServiceID(strServiceID) {}
+
+        const WString& GetID() const override {
+            return m_strID;
+        }
+
+        const WString& GetServiceID() const override {
+            return m_strServiceID;
+        }
+
+        const WStringOptional& GetCountry() const override {
+            return m_strCountry;
+        }
+
+    private:
+        WString m_strID;
+        WString m_strServiceID;
+        WStringOptional m_strCountry;
+    };
+
+    class BenchPeer {
+    public:
+        explicit BenchPeer(const UserIdPtr& pUserId) : m_pUserId(pUserId) {}
+        virtual ~BenchPeer() {}
+
+        virtual UserIdPtr GetUserID() {
+            return m_pUserId;
+        }
+
+    private:
+        UserIdPtr m_pUserId;
+    };
+
+    typedef SharedPtr<BenchPeer> BenchPeerPtr;
+
+    UserIdPtr CreateUserId(size_t nIndex) {
+        wchar_t szID[64];
+        swprintf(szID, 64, L"user-%08zu@example.com", nIndex);
+        return MakeAutoPtr<BenchUserId>(WString(szID), WString(L"line-conference-service"));
+    }
+
+    void BenchPeers(size_t nPeers) {
+        Array<BenchPeerPtr> arrPeers;
+        arrPeers.Resize(nPeers);
+        HashMap<UserIdPtr, size_t> mapPeers;
+
+        // Each frame reports a user ID instance of its own, as IVideoReceiver::OnVideo does.
+        Array<UserIdPtr> arrQueries;
+        arrQueries.Resize(nPeers);
+
+        for (size_t i = 0; i < nPeers; ++i) {
+            UserIdPtr pUserId = CreateUserId(i);
+            arrPeers.SetAt(i, MakeAutoPtr<BenchPeer>(pUserId));
+            mapPeers.Insert(pUserId, i);
+            arrQueries.SetAt(i, CreateUserId((i * 7919) % nPeers));
+        }
+
+        char szCase[64];
+        snprintf(szCase, sizeof(szCase), "linear scan %zu peers", nPeers);
+        Report("PeerLookup", szCase, Measure(Iterations(20000000) / nPeers, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                const UserIdPtr& pQuery = arrQueries[i % nPeers];
+                size_t nFound = nPeers;
+                for (size_t k = 0; k < nPeers; ++k) {
+                    if (arrPeers[k]->GetUserID()->IsSameUser(*pQuery)) {
+                        nFound = k;
+                        break;
+                    }
+                }
+                DoNotOptimize(nFound);
+            }
+        }));
+
+        snprintf(szCase, sizeof(szCase), "HashMap %zu peers", nPeers);
+        Report("PeerLookup", szCase, Measure(Iterations(20000000) / nPeers, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                const size_t* pFound = mapPeers.Find(arrQueries[i % nPeers]);
+                DoNotOptimize(pFound);
+            }
+        }));
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    const size_t peerCounts[] = { 8, 50, 500 };
+    for (size_t nPeers : peerCounts) {
+        BenchPeers(nPeers);
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "PlanetKitHostMemory.h"
+
+namespace PlanetKitBench {
+    /**
+     * Set by --quick. Benchmarks then run a small fraction of their iterations, which is how CTest smoke-runs them.
+     */
+    inline bool& QuickMode() {
+        static bool s_bQuick = false;
+        return s_bQuick;
+    }
+
+    inline void Initialize(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "--quick") == 0) {
+                QuickMode() = true;
+            }
+        }
+    }
+
+    /**
+     * Scales an iteration count down in quick mode.
+     */
+    inline size_t Iterations(size_t nFull) {
+        if (QuickMode()) {
+            nFull /= 1000;
+        }
+        return nFull > 0 ? nFull : 1;
+    }
+
+    /**
+     * Keeps the compiler from discarding a computed value.
+     */
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* s_pSink;
+        s_pSink = &value;
+#endif
+    }
+
+    /**
+     * Result of Measure()
+     */
+    struct SResult {
+        /// Wall time per operation in nanoseconds
+        double dNsPerOp;
+        /// PlanetKitMemory allocations per operation
+        double dAllocationsPerOp;
+    };
+
+    /**
+     * Runs body(nIterations) once to warm up and once timed.
+     * @param body Callable that performs nIterations operations.
+     */
+    template <typename Body>
+    inline SResult Measure(size_t nIterations, Body&& body) {
+        body(nIterations / 10 + 1);
+
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        body(nIterations);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        SResult sResult;
+        sResult.dNsPerOp = std::chrono::duration<double, std::nano>(end - start).count() / nIterations;
+        sResult.dAllocationsPerOp = (double)(PlanetKitHostMemory::GetAllocationCount() - ullAllocations) / nIterations;
+        return sResult;
+    }
+
+    /**
+     * Prints one result line.
+     */
+    inline void Report(const char* szGroup, const char* szCase, const SResult& sResult) {
+        printf("%-24s %-40s %12.1f ns/op %8.2f allocs/op\n", szGroup, szCase, sResult.dNsPerOp, sResult.dAllocationsPerOp);
+    }
+
+    /**
+     * Prints a free-form result line, for numbers that are not a time per operation.
+     */
+    inline void ReportValue(const char* szGroup, const char* szCase, double dValue, const char* szUnit) {
+        printf("%-24s %-40s %12.2f %s\n", szGroup, szCase, dValue, szUnit);
+    }
+};
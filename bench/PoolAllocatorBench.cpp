@@ -0,0 +1,116 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Allocation throughput of PlanetKitPoolAllocator against malloc/free with 1, 4 and 16 threads.
+// Every thread keeps a window of live blocks and replaces the oldest one on each step, with sizes cycling from 16 to 256 bytes.
+
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "PlanetKitPoolAllocator.hpp"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    enum {
+        WINDOW = 64
+    };
+
+    struct SMallocBackend {
+        void* Allocate(size_t size) {
+            return malloc(size);
+        }
+
+        void Free(void* ptr, size_t) {
+            free(ptr);
+        }
+    };
+
+    struct SPoolBackend {
+        PlanetKitPoolAllocator* pPool;
+
+        void* Allocate(size_t size) {
+            return pPool->Allocate(size);
+        }
+
+        void Free(void* ptr, size_t size) {
+            pPool->Free(ptr, size);
+        }
+    };
+
+    template <typename Backend>
+    void Churn(Backend backend, size_t nSteps) {
+        void* pLive[WINDOW] = {};
+        size_t nSizes[WINDOW] = {};
+
+        for (size_t i = 0; i < nSteps; ++i) {
+            size_t nSlot = i % WINDOW;
+            backend.Free(pLive[nSlot], nSizes[nSlot]);
+
+            size_t nSize = 16 + (i * 48) % 241;
+            pLive[nSlot] = backend.Allocate(nSize);
+            nSizes[nSlot] = nSize;
+            static_cast<unsigned char*>(pLive[nSlot])[0] = (unsigned char)i;
+        }
+
+        for (size_t nSlot = 0; nSlot < WINDOW; ++nSlot) {
+            backend.Free(pLive[nSlot], nSizes[nSlot]);
+        }
+    }
+
+    template <typename Backend>
+    void Run(const char* szBackend, Backend backend, unsigned int unThreads, size_t nStepsPerThread) {
+        Churn(backend, nStepsPerThread / 10 + 1);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < unThreads; ++i) {
+            threads.emplace_back([backend, nStepsPerThread]() {
+                Churn(backend, nStepsPerThread);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        double dSeconds = std::chrono::duration<double>(end - start).count();
+        double dOperations = (double)nStepsPerThread * unThreads;
+
+        char szCase[64];
+        snprintf(szCase, sizeof(szCase), "%s %u thread(s)", szBackend, unThreads);
+        ReportValue("PoolAllocator", szCase, dOperations / dSeconds / 1e6, "M alloc+free/s");
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    const unsigned int threadCounts[] = { 1, 4, 16 };
+    size_t nSteps = Iterations(10000000);
+
+    for (unsigned int unThreads : threadCounts) {
+        Run("malloc", SMallocBackend(), unThreads, nSteps);
+
+        PlanetKitPoolAllocator pool;
+        SPoolBackend backend = { &pool };
+        Run("pool", backend, unThreads, nSteps);
+    }
+
+    return 0;
+}
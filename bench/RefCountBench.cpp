@@ -0,0 +1,99 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Cost of copying and dropping a reference with 1 to 32 threads.
+// Uncontended: every thread copies its own pointer. Contended: all threads copy the same pointer, so they fight over one count.
+
+#include <thread>
+#include <vector>
+
+#include "PlanetKit.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    struct SPayload {
+        int nValue = 0;
+    };
+
+    template <typename Ptr>
+    void CopyLoop(const Ptr& ptr, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            Ptr copy(ptr);
+            DoNotOptimize(copy);
+        }
+    }
+
+    template <typename Ptr, typename Factory>
+    double RunThreads(unsigned int unThreads, bool bContended, size_t nCopies, Factory factory) {
+        Ptr shared = factory();
+        std::vector<Ptr> own(unThreads);
+        // Spacers keep the uncontended control blocks off each other's cache lines.
+        std::vector<std::vector<char>> spacers(unThreads);
+        for (unsigned int i = 0; i < unThreads; ++i) {
+            own[i] = bContended ? shared : factory();
+            spacers[i].resize(256);
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < unThreads; ++i) {
+            const Ptr* pPtr = &own[i];
+            threads.emplace_back([pPtr, nCopies]() {
+                CopyLoop(*pPtr, nCopies);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        // Copies plus releases per second across all threads.
+        return (double)nCopies * unThreads / std::chrono::duration<double>(end - start).count();
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    size_t nCopies = Iterations(20000000);
+
+    Report("RefCount", "LocalSharedPtr copy", Measure(nCopies, [](size_t n) {
+        LocalSharedPtr<SPayload> ptr = MakeLocalAutoPtr<SPayload>();
+        CopyLoop(ptr, n);
+    }));
+
+    Report("RefCount", "InplaceSharedPtr copy", Measure(nCopies, [](size_t n) {
+        InplaceSharedPtr<SPayload> ptr = MakeInplaceAutoPtr<SPayload>();
+        CopyLoop(ptr, n);
+    }));
+
+    const unsigned int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    for (unsigned int unThreads : threadCounts) {
+        for (int nContended = 0; nContended < 2; ++nContended) {
+            char szCase[64];
+            snprintf(szCase, sizeof(szCase), "SharedPtr copy %s %u thread(s)", nContended ? "contended" : "uncontended", unThreads);
+
+            double dRate = RunThreads<SharedPtr<SPayload>>(unThreads, nContended != 0, nCopies / unThreads + 1, []() {
+                return MakeAutoPtr<SPayload>();
+            });
+            ReportValue("RefCount", szCase, dRate / 1e6, "M copies/s");
+        }
+    }
+
+    return 0;
+}
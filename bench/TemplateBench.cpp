@@ -0,0 +1,276 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Construction, copy, compare, append and resize costs of the core header templates.
+
+#include "PlanetKit.h"
+#include "PlanetKitCommonTypes.h"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    struct SRefCounted {
+        ULONG AddRef() {
+            return ++m_ulRefCount;
+        }
+
+        ULONG Release() {
+            return --m_ulRefCount;
+        }
+
+        ULONG m_ulRefCount = 1;
+    };
+
+    struct SPayload {
+        int nValue = 0;
+    };
+
+    void BenchString() {
+        const char* szShort = "user-1234";
+        const char* szLong = "a-service-id-that-does-not-fit-in-any-small-buffer";
+
+        Report("String", "construct short", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                String str(szShort);
+                DoNotOptimize(str);
+            }
+        }));
+
+        Report("String", "construct long", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                String str(szLong);
+                DoNotOptimize(str);
+            }
+        }));
+
+        String strSource(szLong);
+        Report("String", "copy long", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                String str(strSource);
+                DoNotOptimize(str);
+            }
+        }));
+
+        String strOther(szLong);
+        Report("String", "compare equal long", Measure(Iterations(5000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                bool bEqual = strSource == strOther.c_str();
+                DoNotOptimize(bEqual);
+            }
+        }));
+
+        Report("String", "append 16 pieces", Measure(Iterations(200000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                String str;
+                for (int k = 0; k < 16; ++k) {
+                    str.Append(szShort);
+                }
+                DoNotOptimize(str);
+            }
+        }));
+    }
+
+    void BenchWString() {
+        const wchar_t* szShort = L"user-1234";
+        const wchar_t* szLong = L"a-service-id-that-does-not-fit-in-any-small-buffer";
+
+        Report("WString", "construct short", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                WString str(szShort);
+                DoNotOptimize(str);
+            }
+        }));
+
+        Report("WString", "construct long", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                WString str(szLong);
+                DoNotOptimize(str);
+            }
+        }));
+
+        WString strSource(szLong);
+        Report("WString", "copy long", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                WString str(strSource);
+                DoNotOptimize(str);
+            }
+        }));
+
+        WString strOther(szLong);
+        Report("WString", "compare equal long", Measure(Iterations(5000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                bool bEqual = strSource == strOther;
+                DoNotOptimize(bEqual);
+            }
+        }));
+
+        // WString appends reallocate to the exact size every time, WStringBuilder grows geometrically.
+        const int pieceCounts[] = { 16, 1000 };
+        for (int nPieces : pieceCounts) {
+            char szCase[64];
+            size_t nIterations = Iterations(3200000) / nPieces;
+
+            snprintf(szCase, sizeof(szCase), "append %d pieces", nPieces);
+            Report("WString", szCase, Measure(nIterations, [&](size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    WString str;
+                    for (int k = 0; k < nPieces; ++k) {
+                        str += szShort;
+                    }
+                    DoNotOptimize(str);
+                }
+            }));
+
+            snprintf(szCase, sizeof(szCase), "WStringBuilder append %d pieces", nPieces);
+            Report("WString", szCase, Measure(nIterations, [&](size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    WStringBuilder builder;
+                    for (int k = 0; k < nPieces; ++k) {
+                        builder.Append(szShort);
+                    }
+                    DoNotOptimize(builder);
+                }
+            }));
+        }
+    }
+
+    void BenchArray() {
+        const size_t sizes[] = { 16, 1024 };
+        for (size_t nSize : sizes) {
+            char szCase[64];
+
+            snprintf(szCase, sizeof(szCase), "Array<int> resize %zu", nSize);
+            Report("Array", szCase, Measure(Iterations(200000), [&](size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    Array<int> array;
+                    array.Resize(nSize);
+                    DoNotOptimize(array);
+                }
+            }));
+
+            snprintf(szCase, sizeof(szCase), "Array<WString> resize %zu", nSize);
+            Report("Array", szCase, Measure(Iterations(20000), [&](size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    Array<WString> array;
+                    array.Resize(nSize);
+                    DoNotOptimize(array);
+                }
+            }));
+
+            snprintf(szCase, sizeof(szCase), "Array<int> fill with SetAt %zu", nSize);
+            Array<int> array;
+            array.Resize(nSize);
+            Report("Array", szCase, Measure(Iterations(200000), [&](size_t n) {
+                for (size_t i = 0; i < n; ++i) {
+                    for (size_t k = 0; k < nSize; ++k) {
+                        array.SetAt(k, (int)k);
+                    }
+                    DoNotOptimize(array);
+                }
+            }));
+        }
+    }
+
+    void BenchSharedPtr() {
+        Report("SharedPtr", "MakeAutoPtr", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                SharedPtr<SPayload> ptr = MakeAutoPtr<SPayload>();
+                DoNotOptimize(ptr);
+            }
+        }));
+
+        Report("SharedPtr", "MakeInplaceAutoPtr", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                InplaceSharedPtr<SPayload> ptr = MakeInplaceAutoPtr<SPayload>();
+                DoNotOptimize(ptr);
+            }
+        }));
+
+        SharedPtr<SPayload> ptrSource = MakeAutoPtr<SPayload>();
+        Report("SharedPtr", "copy", Measure(Iterations(10000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                SharedPtr<SPayload> ptr(ptrSource);
+                DoNotOptimize(ptr);
+            }
+        }));
+
+        SharedPtr<SPayload> ptrOther = ptrSource;
+        Report("SharedPtr", "compare", Measure(Iterations(10000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                bool bEqual = ptrSource == ptrOther;
+                DoNotOptimize(bEqual);
+            }
+        }));
+    }
+
+    void BenchAutoPtr() {
+        SRefCounted object;
+        AutoPtr<SRefCounted> ptrSource(&object);
+        Report("AutoPtr", "copy", Measure(Iterations(10000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AutoPtr<SRefCounted> ptr(ptrSource);
+                DoNotOptimize(ptr);
+            }
+        }));
+    }
+
+    void BenchOptional() {
+        Report("Optional", "WStringOptional empty", Measure(Iterations(10000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                WStringOptional strEmpty;
+                DoNotOptimize(strEmpty);
+            }
+        }));
+
+        WStringOptional strSource(WString(L"breakout-room"));
+        Report("Optional", "WStringOptional copy", Measure(Iterations(2000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                WStringOptional str(strSource);
+                DoNotOptimize(str);
+            }
+        }));
+    }
+
+    void BenchControlBlock() {
+        SPayload* pPayload = static_cast<SPayload*>(PlanetKitMemory::AllocateMemory(sizeof(SPayload)));
+        new (pPayload) SPayload();
+        ControlBlock<SPayload>* pBlock = static_cast<ControlBlock<SPayload>*>(PlanetKitMemory::AllocateMemory(sizeof(ControlBlock<SPayload>)));
+        new (pBlock) ControlBlock<SPayload>(pPayload);
+
+        Report("ControlBlock", "addRef + release", Measure(Iterations(10000000), [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                pBlock->addRef();
+                pBlock->release();
+            }
+        }));
+
+        pBlock->release();
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    BenchString();
+    BenchWString();
+    BenchArray();
+    BenchSharedPtr();
+    BenchAutoPtr();
+    BenchOptional();
+    BenchControlBlock();
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Per-frame descriptor overhead: SVideoFrame against SVideoFrameDesc for a by-value and a by-reference hop, FromLegacy with
+// and without the previous frame's atom, and the resulting cost at 30 fps x 25 streams.
+
+#include "PlanetKitVideoFrameDesc.hpp"
+#include "PlanetKitBench.h"
+
+using namespace PlanetKit;
+using namespace PlanetKitBench;
+
+namespace {
+    const size_t kStreams = 25;
+    const double kFramesPerSecond = 30.0 * kStreams;
+
+    // Each stream's callback gets its frame by value, as a copy hop through an interceptor or renderer does.
+    template <typename Frame>
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((noinline))
+#elif defined(_MSC_VER)
+    __declspec(noinline)
+#endif
+    unsigned int Consume(Frame sFrame) {
+        // Keeps the compiler from reducing the copy to the two fields read here.
+        DoNotOptimize(sFrame);
+        return sFrame.unWidth + sFrame.unHeight;
+    }
+
+    template <typename Frame>
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((noinline))
+#elif defined(_MSC_VER)
+    __declspec(noinline)
+#endif
+    unsigned int ConsumeByReference(const Frame& sFrame) {
+        DoNotOptimize(sFrame);
+        return sFrame.unWidth + sFrame.unHeight;
+    }
+
+    void ReportPerSecond(const char* szCase, const SResult& sResult) {
+        char szName[96];
+        snprintf(szName, sizeof(szName), "%s at 30 fps x %zu", szCase, kStreams);
+        ReportValue("VideoFrame", szName, sResult.dNsPerOp * kFramesPerSecond / 1000.0, "us of CPU per second");
+    }
+};
+
+int main(int argc, char** argv) {
+    Initialize(argc, argv);
+
+    SVideoFrame* pFrames = static_cast<SVideoFrame*>(PlanetKitMemory::AllocateArrayMemory(kStreams * sizeof(SVideoFrame)));
+    SVideoFrameDesc* pDescs = new SVideoFrameDesc[kStreams];
+    for (size_t i = 0; i < kStreams; ++i) {
+        memset(&pFrames[i], 0, sizeof(SVideoFrame));
+        pFrames[i].unWidth = 640;
+        pFrames[i].unHeight = 360;
+        pFrames[i].bSubgroupMain = false;
+        swprintf(pFrames[i].szSubgroupName, PLNK_BUFFER_SIZE_512, L"subgroup-%zu", i % 4);
+        pDescs[i] = SVideoFrameDesc::FromLegacy(pFrames[i]);
+    }
+
+    ReportValue("VideoFrame", "sizeof(SVideoFrame)", (double)sizeof(SVideoFrame), "bytes");
+    ReportValue("VideoFrame", "sizeof(SVideoFrameDesc)", (double)sizeof(SVideoFrameDesc), "bytes");
+
+    SResult sResult = Measure(Iterations(20000000), [&](size_t n) {
+        unsigned int unSum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unSum += Consume<SVideoFrame>(pFrames[i % kStreams]);
+        }
+        DoNotOptimize(unSum);
+    });
+    Report("VideoFrame", "legacy by-value hop", sResult);
+    ReportPerSecond("legacy by-value hop", sResult);
+
+    sResult = Measure(Iterations(20000000), [&](size_t n) {
+        unsigned int unSum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unSum += Consume<SVideoFrameDesc>(pDescs[i % kStreams]);
+        }
+        DoNotOptimize(unSum);
+    });
+    Report("VideoFrame", "desc by-value hop", sResult);
+    ReportPerSecond("desc by-value hop", sResult);
+
+    sResult = Measure(Iterations(20000000), [&](size_t n) {
+        unsigned int unSum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unSum += ConsumeByReference<SVideoFrameDesc>(pDescs[i % kStreams]);
+        }
+        DoNotOptimize(unSum);
+    });
+    Report("VideoFrame", "desc by-reference hop", sResult);
+    ReportPerSecond("desc by-reference hop", sResult);
+
+    sResult = Measure(Iterations(5000000), [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = i % kStreams;
+            pDescs[k] = SVideoFrameDesc::FromLegacy(pFrames[k], pDescs[k].atomSubgroup);
+        }
+        DoNotOptimize(pDescs);
+    });
+    Report("VideoFrame", "FromLegacy with hint", sResult);
+    ReportPerSecond("FromLegacy with hint", sResult);
+
+    sResult = Measure(Iterations(5000000), [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = i % kStreams;
+            pDescs[k] = SVideoFrameDesc::FromLegacy(pFrames[k]);
+        }
+        DoNotOptimize(pDescs);
+    });
+    Report("VideoFrame", "FromLegacy without hint", sResult);
+    ReportPerSecond("FromLegacy without hint", sResult);
+
+    delete[] pDescs;
+    PlanetKitMemory::FreeArrayMemory(pFrames);
+    return 0;
+}
@@ -17,13 +17,20 @@
 #include "PlanetKitPredefine.h"
 #include "PlanetKitAutoPtr.hpp"
 #include "PlanetKitSharedPtr.hpp"
+#include "PlanetKitWeakPtr.hpp"
+#include "PlanetKitAtomicSharedPtr.hpp"
 #include "PlanetKitOptional.hpp"
 #include "PlanetKitContainer.hpp"
+#include "PlanetKitArrayBuilder.hpp"
 #include "PlanetKitString.hpp"
+#include "PlanetKitWStringBuilder.hpp"
+#include "PlanetKitHashMap.hpp"
 
 
+#ifdef _MSC_VER
 // CLASS1 inherits CLASS2::member via dominance
 #pragma warning(disable: 4250)
+#endif
 
 
 #define PLNK_BUFFER_SIZE_256                    256
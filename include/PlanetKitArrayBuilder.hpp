@@ -0,0 +1,169 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "PlanetKitContainer.hpp"
+
+namespace PlanetKit {
+    /**
+     * Builds an Array by appending elements.
+     * @remark
+     *   The buffer grows geometrically, so appending n elements costs O(n).<br>
+     *   Call Reserve() up front when the final size is known to build the array with a single allocation.<br>
+     *   Array itself has no room to record a capacity, so the builder keeps track of it. Only the array returned by
+     *   TakeArray() may be handed to the SDK.
+     */
+    template <class T>
+    class ArrayBuilder {
+    public:
+        ArrayBuilder() = default;
+
+        ArrayBuilder(const ArrayBuilder<T>& src) = delete;
+        ArrayBuilder<T>& operator=(const ArrayBuilder<T>& src) = delete;
+
+        /**
+         * Allocates memory for at least capacity elements without changing Size().
+         * @param capacity Number of elements to allocate memory for
+         * @return false if the memory could not be allocated. The builder is unchanged then.
+         */
+        bool Reserve(size_t capacity) {
+            if (capacity <= m_nCapacity) {
+                return true;
+            }
+
+            T* pBuffer = Array<T>::AllocateBuffer(capacity);
+            if (pBuffer == nullptr) {
+                return false;
+            }
+
+            m_arr.Adopt(pBuffer);
+            m_nCapacity = capacity;
+            return true;
+        }
+
+        /**
+         * Gets the number of elements the builder can hold without reallocating memory.
+         */
+        size_t Capacity() const {
+            return m_nCapacity;
+        }
+
+        /**
+         * Appends an element at the end of the array.
+         * @param rhs Element value to be appended.
+         * @return false if the memory could not be allocated. The builder is unchanged then.
+         */
+        bool PushBack(const T& rhs) {
+            return EmplaceBack(rhs);
+        }
+
+        /**
+         * Appends an element at the end of the array.
+         * @param rhs Element value to be appended.
+         * @return false if the memory could not be allocated. The builder is unchanged then.
+         */
+        bool PushBack(T&& rhs) {
+            return EmplaceBack(std::move(rhs));
+        }
+
+        /**
+         * Constructs an element at the end of the array.
+         * @param args Arguments forwarded to the constructor of the element. They may refer to elements of this builder.
+         * @return false if the memory could not be allocated. The builder is unchanged then.
+         */
+        template <typename... Args>
+        bool EmplaceBack(Args&&... args) {
+            size_t nSize = m_arr.m_nSize;
+            if (nSize < m_nCapacity) {
+                new (&m_arr.m_pData[nSize]) T(std::forward<Args>(args)...);
+            }
+            else {
+                size_t capacity = m_nCapacity + m_nCapacity / 2;
+                if (capacity < 4) {
+                    capacity = 4;
+                }
+                if (capacity <= nSize) {
+                    return false;
+                }
+
+                T* pBuffer = Array<T>::AllocateBuffer(capacity);
+                if (pBuffer == nullptr) {
+                    return false;
+                }
+
+                // Construct the new element while the elements args may refer to are still in place.
+                new (&pBuffer[nSize]) T(std::forward<Args>(args)...);
+                m_arr.Adopt(pBuffer);
+                m_nCapacity = capacity;
+            }
+
+            m_arr.m_nSize = nSize + 1;
+            return true;
+        }
+
+        /**
+         * Removes the last element. The capacity is kept.
+         * @remark The builder must not be empty.
+         */
+        void PopBack() {
+            m_arr.PopBack();
+        }
+
+        /**
+         * Removes all elements. The capacity is kept.
+         */
+        void Clear() {
+            m_arr.DestroyRange(0, m_arr.m_nSize);
+            m_arr.m_nSize = 0;
+        }
+
+        /**
+         * Gets the number of elements built so far.
+         */
+        size_t Size() const {
+            return m_arr.Size();
+        }
+
+        /**
+         * Gets the element at idx.
+         * @param idx Index of the array
+         * @return Element item
+         */
+        T& operator[](size_t idx) const {
+            return m_arr[idx];
+        }
+
+        /**
+         * Gets a read-only view of the elements built so far.
+         * @remark The view is invalidated by any call that appends to the builder.
+         */
+        ArrayView<const T> View() const {
+            return m_arr.View();
+        }
+
+        /**
+         * Moves the built array out of the builder. The builder becomes empty.
+         * @remark The array keeps the spare capacity of the buffer until it is resized or cleared.
+         */
+        Array<T> TakeArray() {
+            m_nCapacity = 0;
+            return std::move(m_arr);
+        }
+
+    private:
+        Array<T> m_arr;
+        size_t m_nCapacity = 0;
+    };
+};
@@ -0,0 +1,173 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+#include "PlanetKitSharedPtr.hpp"
+
+namespace PlanetKit {
+    /**
+     * SharedPtr slot that can be loaded and replaced concurrently without a lock.
+     * @remark
+     *   Use it for handler slots that a realtime thread reads while another thread registers or deregisters the handler.<br>
+     *   The slot keeps a small local count next to the control block pointer (split reference counting). load() bumps the
+     *   local count with a single atomic add, takes a real reference, and gives the local count back. Without a concurrent
+     *   store() this is one atomic add and one compare-exchange on the slot, and it never blocks or allocates.
+     *   store() moves the pending local count onto the old control block before dropping its own reference, so readers
+     *   in flight always keep the old object alive.<br>
+     *   The slot must not be destroyed while another thread is still calling load() or store() on it.<br>
+     *   For code written against a SharedPtr member, the slot also offers hasValue(), operator-> and conversion to SharedPtr.
+     *   Each of them works on a fresh load(), so the object stays alive for the whole expression.
+     */
+    template <typename T>
+    class AtomicSharedPtr {
+    public:
+        AtomicSharedPtr() : m_ullPacked(0) {
+        }
+
+        explicit AtomicSharedPtr(SharedPtr<T> ptr) : m_ullPacked(Pack(ptr.control_block_, 0)) {
+            ptr.control_block_ = nullptr;
+        }
+
+        AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+        AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+        ~AtomicSharedPtr() {
+            ControlBlock<T>* pControlBlock = Unpack(m_ullPacked.load(std::memory_order_acquire));
+            if (pControlBlock) {
+                pControlBlock->release();
+            }
+        }
+
+        /**
+         * Gets a SharedPtr to the current object.
+         * @return SharedPtr that keeps the object alive even if it is replaced right after.
+         */
+        SharedPtr<T> load() const {
+            uint64_t ullPacked = m_ullPacked.fetch_add(LOCAL_COUNT_ONE, std::memory_order_acquire);
+            ControlBlock<T>* pControlBlock = Unpack(ullPacked);
+            if (pControlBlock == nullptr) {
+                ReturnLocalCount(ullPacked + LOCAL_COUNT_ONE, nullptr);
+                return SharedPtr<T>();
+            }
+
+            pControlBlock->addRef();
+            ReturnLocalCount(ullPacked + LOCAL_COUNT_ONE, pControlBlock);
+            return SharedPtr<T>(pControlBlock);
+        }
+
+        /**
+         * Replaces the current object with ptr.
+         */
+        void store(SharedPtr<T> ptr) {
+            SharedPtr<T> old = exchange(std::move(ptr));
+        }
+
+        /**
+         * Replaces the current object with ptr.
+         * @return The previous object.
+         */
+        SharedPtr<T> exchange(SharedPtr<T> ptr) {
+            uint64_t ullOld = m_ullPacked.exchange(Pack(ptr.control_block_, 0), std::memory_order_acq_rel);
+            ptr.control_block_ = nullptr;
+
+            ControlBlock<T>* pOld = Unpack(ullOld);
+            if (pOld) {
+                LONG nLocalCount = (LONG)(ullOld >> POINTER_BITS);
+                if (nLocalCount > 0) {
+                    pOld->addRef(nLocalCount);
+                }
+            }
+
+            // Takes over the reference the slot held.
+            return SharedPtr<T>(pOld);
+        }
+
+        AtomicSharedPtr& operator=(SharedPtr<T> ptr) {
+            store(std::move(ptr));
+            return *this;
+        }
+
+        AtomicSharedPtr& operator=(std::nullptr_t) {
+            store(SharedPtr<T>());
+            return *this;
+        }
+
+        /**
+         * Gets a SharedPtr to the current object. Same as load().
+         */
+        operator SharedPtr<T>() const {
+            return load();
+        }
+
+        /**
+         * Calls a member of the current object. The returned SharedPtr keeps it alive until the end of the expression.
+         */
+        SharedPtr<T> operator->() const {
+            return load();
+        }
+
+        /**
+         * Checks whether an object is set. Use load() instead when the object is also used afterwards.
+         */
+        bool hasValue() const {
+            return Unpack(m_ullPacked.load(std::memory_order_acquire)) != nullptr;
+        }
+
+        bool operator==(std::nullptr_t) const {
+            return hasValue() == false;
+        }
+
+        bool operator!=(std::nullptr_t) const {
+            return hasValue();
+        }
+
+    private:
+        static const unsigned int POINTER_BITS = 48;
+        static const uint64_t POINTER_MASK = ((uint64_t)1 << POINTER_BITS) - 1;
+        static const uint64_t LOCAL_COUNT_ONE = (uint64_t)1 << POINTER_BITS;
+
+        static_assert(sizeof(void*) <= 8, "AtomicSharedPtr packs pointers into 64 bits");
+
+        static uint64_t Pack(ControlBlock<T>* pControlBlock, uint64_t ullLocalCount) {
+            return (uint64_t)reinterpret_cast<uintptr_t>(pControlBlock) | (ullLocalCount << POINTER_BITS);
+        }
+
+        static ControlBlock<T>* Unpack(uint64_t ullPacked) {
+            return reinterpret_cast<ControlBlock<T>*>((uintptr_t)(ullPacked & POINTER_MASK));
+        }
+
+        /**
+         * Gives back the local count taken by load(). If pControlBlock has been replaced meanwhile, the count was moved
+         * onto its reference count by exchange(), so that reference is released instead.
+         */
+        void ReturnLocalCount(uint64_t ullExpected, ControlBlock<T>* pControlBlock) const {
+            while (Unpack(ullExpected) == pControlBlock && (ullExpected >> POINTER_BITS) != 0) {
+                if (m_ullPacked.compare_exchange_weak(ullExpected, ullExpected - LOCAL_COUNT_ONE, std::memory_order_release, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            if (pControlBlock) {
+                pControlBlock->release();
+            }
+        }
+
+        mutable std::atomic<uint64_t> m_ullPacked;
+    };
+};
@@ -0,0 +1,398 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+
+#include "PlanetKitAudioDefine.h"
+
+/// Largest number of distinct (sampling rate, sample count, sample format) shapes one AudioFramePool serves
+#define PLNK_AUDIO_FRAME_POOL_MAX_SHAPES (16)
+
+namespace PlanetKit {
+    class AudioFramePool;
+    class AudioFramePtr;
+
+    /**
+     * Configuration of AudioFramePool
+     */
+    typedef struct SAudioFramePoolConfig {
+        /// Alignment of every frame buffer in bytes. Must be a power of two.
+        unsigned int unAlignment = 64;
+    } SAudioFramePoolConfig;
+
+    /**
+     * Counters of AudioFramePool
+     */
+    typedef struct SAudioFramePoolStatistics {
+        /// Frames handed out by Acquire and AcquireCopy
+        uint64_t ullAcquired = 0;
+        /// Frames taken from the heap. This stops growing once the pool holds the peak number of frames in use.
+        uint64_t ullAllocated = 0;
+        /// Acquire calls that failed because the pool was out of shapes or memory
+        uint64_t ullFailed = 0;
+        /// Frames currently handed out
+        uint64_t ullOutstanding = 0;
+    } SAudioFramePoolStatistics;
+
+    /**
+     * Pooled PCM frame. Its buffer follows it in the same aligned allocation.
+     */
+    class AudioFrame {
+    public:
+        /**
+         * Gets the audio data of this frame.
+         * @remark
+         *   ucBuffer points at the frame buffer and unBufferSize is its size. The fields may be changed while the frame is
+         *   held, for example by CustomSpeaker::PullAudioData, and are restored when the frame returns to the pool.
+         */
+        SAudioData& GetAudioData() {
+            return m_sAudioData;
+        }
+
+        const SAudioData& GetAudioData() const {
+            return m_sAudioData;
+        }
+
+        /**
+         * Gets the size of the frame buffer in bytes.
+         */
+        unsigned int GetCapacity() const {
+            return m_unCapacity;
+        }
+
+    private:
+        friend class AudioFramePool;
+        friend class AudioFramePtr;
+
+        AudioFrame(void* pShelf, const SAudioData& sShape, unsigned char* pBuffer) : m_pShelf(pShelf), m_sAudioData(sShape), m_unCapacity(sShape.unBufferSize) {
+            m_sAudioData.ucBuffer = pBuffer;
+        }
+
+        std::atomic<long> m_lRefCount{ 0 };
+        std::atomic<AudioFrame*> m_pNext{ nullptr };
+        void* m_pShelf;
+        SAudioData m_sAudioData;
+        unsigned int m_unCapacity;
+    };
+
+    /**
+     * Reference to a pooled AudioFrame. The frame returns to its pool when the last reference goes away.
+     * @remark
+     *   Copying a reference costs one atomic increment. References may be copied, moved and released on any thread,
+     *   so a frame filled on the capture thread can be handed to a worker and recycled there.
+     */
+    class AudioFramePtr {
+    public:
+        AudioFramePtr() : m_pFrame(nullptr) {
+        }
+
+        AudioFramePtr(const AudioFramePtr& src) : m_pFrame(src.m_pFrame) {
+            if (m_pFrame) {
+                m_pFrame->m_lRefCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        AudioFramePtr(AudioFramePtr&& src) : m_pFrame(src.m_pFrame) {
+            src.m_pFrame = nullptr;
+        }
+
+        ~AudioFramePtr() {
+            reset();
+        }
+
+        AudioFramePtr& operator=(const AudioFramePtr& src) {
+            AudioFramePtr(src).swap(*this);
+            return *this;
+        }
+
+        AudioFramePtr& operator=(AudioFramePtr&& src) {
+            AudioFramePtr(std::move(src)).swap(*this);
+            return *this;
+        }
+
+        AudioFrame* get() const {
+            return m_pFrame;
+        }
+
+        AudioFrame* operator->() const {
+            return m_pFrame;
+        }
+
+        AudioFrame& operator*() const {
+            return *m_pFrame;
+        }
+
+        explicit operator bool() const {
+            return m_pFrame != nullptr;
+        }
+
+        void swap(AudioFramePtr& other) {
+            AudioFrame* pFrame = m_pFrame;
+            m_pFrame = other.m_pFrame;
+            other.m_pFrame = pFrame;
+        }
+
+        /**
+         * Drops this reference. The frame goes back to its pool if it was the last one.
+         */
+        inline void reset();
+
+    private:
+        friend class AudioFramePool;
+
+        explicit AudioFramePtr(AudioFrame* pFrame) : m_pFrame(pFrame) {
+        }
+
+        AudioFrame* m_pFrame;
+    };
+
+    /**
+     * Lock-free pool of reference-counted PCM frames, keyed by sampling rate, sample count and sample format.
+     * @remark
+     *   Each shape has its own free list, a lock-free stack with a generation tag against ABA. Acquire pops a frame and
+     *   only allocates when the list is empty, so once the pool has seen the peak number of frames in flight, or after
+     *   Reserve, the 10 ms audio path does no heap operation at all. Released frames are never given back to the heap
+     *   until the pool is destroyed.<br>
+     *   Acquire, AcquireCopy, Reserve and releasing frames are safe from any thread. Every frame must be released before
+     *   the pool is destroyed.
+     */
+    class AudioFramePool {
+    public:
+        explicit AudioFramePool(const SAudioFramePoolConfig& sConfig = SAudioFramePoolConfig()) : m_sConfig(sConfig) {
+            if (m_sConfig.unAlignment < alignof(AudioFrame) || (m_sConfig.unAlignment & (m_sConfig.unAlignment - 1)) != 0) {
+                m_sConfig.unAlignment = 64;
+            }
+            for (int i = 0; i < PLNK_AUDIO_FRAME_POOL_MAX_SHAPES; ++i) {
+                m_shelves[i].m_pPool = this;
+            }
+        }
+
+        AudioFramePool(const AudioFramePool&) = delete;
+        AudioFramePool& operator=(const AudioFramePool&) = delete;
+
+        ~AudioFramePool() {
+            for (int i = 0; i < PLNK_AUDIO_FRAME_POOL_MAX_SHAPES; ++i) {
+                AudioFrame* pFrame;
+                while ((pFrame = Pop(m_shelves[i])) != nullptr) {
+                    pFrame->~AudioFrame();
+                    PlanetKitMemory::FreeAlignedMemory(pFrame);
+                }
+            }
+        }
+
+        /**
+         * Gets a frame of the given shape.
+         * @return The frame with unAudioDataSamplingRate, unAudioDataSampleCount, eAudioDataSampleFormat, ucBuffer and
+         *   unBufferSize set, or an empty reference if the pool already serves PLNK_AUDIO_FRAME_POOL_MAX_SHAPES other shapes
+         *   or memory runs out. The buffer content is undefined.
+         */
+        AudioFramePtr Acquire(unsigned int unSamplingRate, unsigned int unSampleCount, EAudioDataSampleType eFormat) {
+            Shelf* pShelf = FindShelf(unSamplingRate, unSampleCount, eFormat);
+            AudioFrame* pFrame = pShelf ? Pop(*pShelf) : nullptr;
+            if (pShelf && pFrame == nullptr) {
+                pFrame = Allocate(*pShelf);
+            }
+            if (pFrame == nullptr) {
+                m_ullFailed.fetch_add(1, std::memory_order_relaxed);
+                return AudioFramePtr();
+            }
+
+            pFrame->m_lRefCount.store(1, std::memory_order_relaxed);
+            m_ullAcquired.fetch_add(1, std::memory_order_relaxed);
+            m_ullOutstanding.fetch_add(1, std::memory_order_relaxed);
+            return AudioFramePtr(pFrame);
+        }
+
+        /**
+         * Gets a frame of the shape of src and copies src into it, for example to keep audio passed to
+         * IPlanetKitAudioReceiver::OnAudio beyond the callback.
+         * @remark unBufferSize of src decides how many bytes are copied. The shape uses the sample count it implies.
+         */
+        AudioFramePtr AcquireCopy(const SAudioData& src) {
+            unsigned int unSampleCount = src.unBufferSize / BytesPerSample(src.eAudioDataSampleFormat);
+            AudioFramePtr frame = Acquire(src.unAudioDataSamplingRate, unSampleCount, src.eAudioDataSampleFormat);
+            if (frame) {
+                memcpy(frame->m_sAudioData.ucBuffer, src.ucBuffer, unSampleCount * BytesPerSample(src.eAudioDataSampleFormat));
+            }
+            return frame;
+        }
+
+        /**
+         * Makes sure at least nFrames frames of the given shape are free, so that the first calls of Acquire do not allocate.
+         * @return false if the shape cannot be served or memory runs out.
+         */
+        bool Reserve(unsigned int unSamplingRate, unsigned int unSampleCount, EAudioDataSampleType eFormat, size_t nFrames) {
+            Shelf* pShelf = FindShelf(unSamplingRate, unSampleCount, eFormat);
+            if (pShelf == nullptr) {
+                return false;
+            }
+
+            size_t nFree = pShelf->m_nFree.load(std::memory_order_relaxed);
+            for (; nFree < nFrames; ++nFree) {
+                AudioFrame* pFrame = Allocate(*pShelf);
+                if (pFrame == nullptr) {
+                    return false;
+                }
+                Push(*pShelf, pFrame);
+            }
+            return true;
+        }
+
+        /**
+         * Gets the counters of this pool.
+         */
+        SAudioFramePoolStatistics GetStatistics() const {
+            SAudioFramePoolStatistics sStatistics;
+            sStatistics.ullAcquired = m_ullAcquired.load(std::memory_order_relaxed);
+            sStatistics.ullAllocated = m_ullAllocated.load(std::memory_order_relaxed);
+            sStatistics.ullFailed = m_ullFailed.load(std::memory_order_relaxed);
+            sStatistics.ullOutstanding = m_ullOutstanding.load(std::memory_order_relaxed);
+            return sStatistics;
+        }
+
+    private:
+        friend class AudioFramePtr;
+
+        struct Shelf {
+            /// Packed shape, or zero while the shelf is unused
+            std::atomic<uint64_t> m_ullKey{ 0 };
+            /// Top of the free list: frame pointer in the low 48 bits and a generation tag above
+            std::atomic<uint64_t> m_ullHead{ 0 };
+            /// Frames on the free list, including a push still in progress. Never less than the frames that can be popped
+            std::atomic<size_t> m_nFree{ 0 };
+            AudioFramePool* m_pPool = nullptr;
+        };
+
+        static const unsigned int POINTER_BITS = 48;
+        static const uint64_t POINTER_MASK = ((uint64_t)1 << POINTER_BITS) - 1;
+        static const uint64_t TAG_ONE = (uint64_t)1 << POINTER_BITS;
+
+        static_assert(sizeof(void*) <= 8, "AudioFramePool packs pointers into 64 bits");
+
+        static unsigned int BytesPerSample(EAudioDataSampleType eFormat) {
+            return eFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 ? 4 : 2;
+        }
+
+        static AudioFrame* Unpack(uint64_t ullPacked) {
+            return reinterpret_cast<AudioFrame*>((uintptr_t)(ullPacked & POINTER_MASK));
+        }
+
+        static SAudioData ShapeOf(uint64_t ullKey) {
+            SAudioData sShape = {};
+            sShape.unAudioDataSamplingRate = (unsigned int)(ullKey >> 32);
+            sShape.unAudioDataSampleCount = (unsigned int)((ullKey & 0xFFFFFFFF) >> 1);
+            sShape.eAudioDataSampleFormat = (ullKey & 1) ? PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 : PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+            sShape.unBufferSize = sShape.unAudioDataSampleCount * BytesPerSample(sShape.eAudioDataSampleFormat);
+            return sShape;
+        }
+
+        Shelf* FindShelf(unsigned int unSamplingRate, unsigned int unSampleCount, EAudioDataSampleType eFormat) {
+            if (unSamplingRate == 0 || unSampleCount == 0 || unSampleCount > 0x7FFFFFFF / 4) {
+                return nullptr;
+            }
+
+            uint64_t ullKey = ((uint64_t)unSamplingRate << 32) | ((uint64_t)unSampleCount << 1) | (eFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 ? 1 : 0);
+            for (int i = 0; i < PLNK_AUDIO_FRAME_POOL_MAX_SHAPES; ++i) {
+                uint64_t ullCurrent = m_shelves[i].m_ullKey.load(std::memory_order_acquire);
+                if (ullCurrent == 0) {
+                    // Shelves are claimed in order, so a racing claim of the same shape lands on this shelf too.
+                    uint64_t ullExpected = 0;
+                    if (m_shelves[i].m_ullKey.compare_exchange_strong(ullExpected, ullKey, std::memory_order_acq_rel)) {
+                        return &m_shelves[i];
+                    }
+                    ullCurrent = ullExpected;
+                }
+                if (ullCurrent == ullKey) {
+                    return &m_shelves[i];
+                }
+            }
+            return nullptr;
+        }
+
+        AudioFrame* Allocate(Shelf& shelf) {
+            SAudioData sShape = ShapeOf(shelf.m_ullKey.load(std::memory_order_relaxed));
+
+            size_t nHeader = (sizeof(AudioFrame) + m_sConfig.unAlignment - 1) & ~(size_t)(m_sConfig.unAlignment - 1);
+            unsigned char* pMemory = static_cast<unsigned char*>(PlanetKitMemory::AllocateAlignedMemory(nHeader + sShape.unBufferSize, m_sConfig.unAlignment));
+            if (pMemory == nullptr) {
+                return nullptr;
+            }
+
+            m_ullAllocated.fetch_add(1, std::memory_order_relaxed);
+            return new (pMemory) AudioFrame(&shelf, sShape, pMemory + nHeader);
+        }
+
+        static void Push(Shelf& shelf, AudioFrame* pFrame) {
+            // Count the frame before it can be popped, so that m_nFree never drops below zero and Reserve never reads a
+            // wrapped value.
+            shelf.m_nFree.fetch_add(1, std::memory_order_relaxed);
+            uint64_t ullHead = shelf.m_ullHead.load(std::memory_order_relaxed);
+            uint64_t ullNew;
+            do {
+                pFrame->m_pNext.store(Unpack(ullHead), std::memory_order_relaxed);
+                ullNew = (uint64_t)(uintptr_t)pFrame | ((ullHead & ~POINTER_MASK) + TAG_ONE);
+            } while (!shelf.m_ullHead.compare_exchange_weak(ullHead, ullNew, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        static AudioFrame* Pop(Shelf& shelf) {
+            uint64_t ullHead = shelf.m_ullHead.load(std::memory_order_acquire);
+            for (;;) {
+                AudioFrame* pFrame = Unpack(ullHead);
+                if (pFrame == nullptr) {
+                    return nullptr;
+                }
+
+                // pFrame may be popped and pushed again meanwhile. Its memory stays valid, and the tag makes the exchange fail.
+                uint64_t ullNew = (uint64_t)(uintptr_t)pFrame->m_pNext.load(std::memory_order_relaxed) | ((ullHead & ~POINTER_MASK) + TAG_ONE);
+                if (shelf.m_ullHead.compare_exchange_weak(ullHead, ullNew, std::memory_order_acquire, std::memory_order_acquire)) {
+                    shelf.m_nFree.fetch_sub(1, std::memory_order_relaxed);
+                    return pFrame;
+                }
+            }
+        }
+
+        static void Recycle(AudioFrame* pFrame) {
+            Shelf& shelf = *static_cast<Shelf*>(pFrame->m_pShelf);
+
+            unsigned char* pBuffer = pFrame->m_sAudioData.ucBuffer;
+            pFrame->m_sAudioData = ShapeOf(shelf.m_ullKey.load(std::memory_order_relaxed));
+            pFrame->m_sAudioData.ucBuffer = pBuffer;
+
+            shelf.m_pPool->m_ullOutstanding.fetch_sub(1, std::memory_order_relaxed);
+            Push(shelf, pFrame);
+        }
+
+    private:
+        SAudioFramePoolConfig m_sConfig;
+        Shelf m_shelves[PLNK_AUDIO_FRAME_POOL_MAX_SHAPES];
+
+        std::atomic<uint64_t> m_ullAcquired{ 0 };
+        std::atomic<uint64_t> m_ullAllocated{ 0 };
+        std::atomic<uint64_t> m_ullFailed{ 0 };
+        std::atomic<uint64_t> m_ullOutstanding{ 0 };
+    };
+
+    inline void AudioFramePtr::reset() {
+        if (m_pFrame && m_pFrame->m_lRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            AudioFramePool::Recycle(m_pFrame);
+        }
+        m_pFrame = nullptr;
+    }
+};
@@ -0,0 +1,462 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "PlanetKitAudioSampleConverter.hpp"
+
+/// Largest number of filter phases. Ratios that reduce to more phases use the nearest one.
+#define PLNK_AUDIO_RESAMPLER_MAX_PHASES (1024)
+/// Largest number of interleaved channels
+#define PLNK_AUDIO_RESAMPLER_MAX_CHANNELS (8)
+
+namespace PlanetKit {
+    /**
+     * Configuration of AudioResampler
+     */
+    typedef struct SAudioResamplerConfig {
+        /// Sampling rate of the input in Hz
+        unsigned int unInputSamplingRate = 44100;
+        /// Sampling rate of the output in Hz
+        unsigned int unOutputSamplingRate = 48000;
+        /// Number of interleaved channels, up to PLNK_AUDIO_RESAMPLER_MAX_CHANNELS
+        unsigned int unChannels = 1;
+        /// Filter length in samples of the lower of the two rates, rounded up to a multiple of 8.
+        /// Longer filters have a narrower transition band and cost proportionally more.
+        unsigned int unTaps = 64;
+        /// Stopband attenuation in dB
+        unsigned int unStopbandDb = 80;
+        /// Input frames processed per internal block. Scratch memory is allocated for one block up front.
+        unsigned int unBlockFrames = 480;
+    } SAudioResamplerConfig;
+
+    /**
+     * Streaming polyphase sampling rate converter.
+     * @remark
+     *   The rate ratio is reduced to L/M and a Kaiser windowed sinc filter is split into L phases, so each output sample
+     *   costs unTaps multiply-adds per channel whatever the ratio. Ratios with more than PLNK_AUDIO_RESAMPLER_MAX_PHASES
+     *   phases keep their exact average rate and use the nearest of PLNK_AUDIO_RESAMPLER_MAX_PHASES phases, plus one
+     *   more phase that stands for phase 0 of the next input sample.<br>
+     *   The 48 kHz, 32 kHz and 16 kHz rates reduce to at most three phases, so the whole filter bank stays in cache, and
+     *   pure decimation skips phase tracking. The dot products use the SIMD level of AudioSampleConverter.<br>
+     *   Filter history is kept between calls, so consecutive SAudioData frames of one stream give a continuous output.
+     *   To feed a CustomMic at the session rate, resample each captured frame and pass the result to PutAudioData. To play
+     *   a CustomSpeaker on a device with another rate, resample what PullAudioData returns.<br>
+     *   An instance is not thread-safe. No memory is allocated after construction. If construction cannot allocate its
+     *   memory, Process() returns false.
+     */
+    class AudioResampler {
+    public:
+        explicit AudioResampler(const SAudioResamplerConfig& sConfig = SAudioResamplerConfig()) : m_sConfig(sConfig) {
+            if (m_sConfig.unChannels == 0 || m_sConfig.unChannels > PLNK_AUDIO_RESAMPLER_MAX_CHANNELS) {
+                m_sConfig.unChannels = 1;
+            }
+            if (m_sConfig.unBlockFrames == 0) {
+                m_sConfig.unBlockFrames = 480;
+            }
+            if (m_sConfig.unInputSamplingRate == 0 || m_sConfig.unOutputSamplingRate == 0) {
+                m_sConfig.unOutputSamplingRate = m_sConfig.unInputSamplingRate = 48000;
+            }
+
+            unsigned int unGcd = Gcd(m_sConfig.unInputSamplingRate, m_sConfig.unOutputSamplingRate);
+            m_unUp = m_sConfig.unOutputSamplingRate / unGcd;
+            m_unDown = m_sConfig.unInputSamplingRate / unGcd;
+            m_unStepWhole = m_unDown / m_unUp;
+            m_unStepFraction = m_unDown % m_unUp;
+            m_unPhaseCount = m_unUp < PLNK_AUDIO_RESAMPLER_MAX_PHASES ? m_unUp : PLNK_AUDIO_RESAMPLER_MAX_PHASES;
+            // Rounding a phase to the nearest of unPhaseCount can give unPhaseCount itself, which gets a filter of its own.
+            m_unFilterCount = m_unPhaseCount == m_unUp ? m_unPhaseCount : m_unPhaseCount + 1;
+
+            // Downsampling stretches the filter by M/L, so the transition band keeps its width relative to the output rate.
+            unsigned int unBaseTaps = RoundUp8(m_sConfig.unTaps ? m_sConfig.unTaps : 8);
+            m_nTaps = unBaseTaps;
+            if (m_unDown > m_unUp) {
+                m_nTaps = RoundUp8((size_t)ceil((double)unBaseTaps * m_unDown / m_unUp));
+                m_nTaps = m_nTaps < 512 ? m_nTaps : 512;
+            }
+
+            m_nHistoryStride = RoundUp8(m_nTaps - 1 + m_sConfig.unBlockFrames);
+            m_pCoefficients = static_cast<float*>(PlanetKitMemory::AllocateAlignedMemory(m_unFilterCount * m_nTaps * sizeof(float), 32));
+            m_pHistory = static_cast<float*>(PlanetKitMemory::AllocateAlignedMemory(m_sConfig.unChannels * m_nHistoryStride * sizeof(float), 32));
+            m_pInputScratch = static_cast<float*>(PlanetKitMemory::AllocateAlignedMemory(m_sConfig.unBlockFrames * m_sConfig.unChannels * sizeof(float), 32));
+            m_pOutputScratch = static_cast<float*>(PlanetKitMemory::AllocateAlignedMemory(GetMaxOutputFrames(m_sConfig.unBlockFrames) * m_sConfig.unChannels * sizeof(float), 32));
+            if (m_pCoefficients == nullptr || m_pHistory == nullptr || m_pInputScratch == nullptr || m_pOutputScratch == nullptr) {
+                FreeBuffers();
+                return;
+            }
+
+            DesignFilter(unBaseTaps);
+            Reset();
+        }
+
+        AudioResampler(const AudioResampler&) = delete;
+        AudioResampler& operator=(const AudioResampler&) = delete;
+
+        ~AudioResampler() {
+            FreeBuffers();
+        }
+
+        /**
+         * Gets the configuration in use, after invalid values have been replaced.
+         */
+        const SAudioResamplerConfig& GetConfig() const {
+            return m_sConfig;
+        }
+
+        /**
+         * Clears the filter history, as at construction.
+         */
+        void Reset() {
+            if (m_pHistory) {
+                memset(m_pHistory, 0, m_sConfig.unChannels * m_nHistoryStride * sizeof(float));
+            }
+            m_nPosition = m_nTaps - 1;
+            m_unPhase = 0;
+        }
+
+        /**
+         * Gets the delay the filter adds, in input frames.
+         */
+        double GetLatencyInputFrames() const {
+            return (double)(m_nTaps * m_unPhaseCount - 1) / (2.0 * m_unPhaseCount);
+        }
+
+        /**
+         * Gets the delay the filter adds, in microseconds.
+         */
+        unsigned int GetLatencyMicroseconds() const {
+            return (unsigned int)(GetLatencyInputFrames() * 1000000.0 / m_sConfig.unInputSamplingRate + 0.5);
+        }
+
+        /**
+         * Gets the most output frames one call can produce from nInputFrames input frames.
+         */
+        size_t GetMaxOutputFrames(size_t nInputFrames) const {
+            return (size_t)(((uint64_t)nInputFrames * m_unUp + m_unDown - 1) / m_unDown);
+        }
+
+        /**
+         * Resamples interleaved float samples.
+         * @param pInput nInputFrames frames of unChannels samples
+         * @param pOutput Room for nOutputCapacity frames
+         * @param nOutputFrames Set to the number of frames written
+         * @return false if nOutputCapacity is less than GetMaxOutputFrames(nInputFrames), or construction could not allocate
+         *   its memory. Nothing is consumed then.
+         */
+        bool Process(const float* pInput, size_t nInputFrames, float* pOutput, size_t nOutputCapacity, size_t& nOutputFrames) {
+            nOutputFrames = 0;
+            if (m_pHistory == nullptr || nOutputCapacity < GetMaxOutputFrames(nInputFrames)) {
+                return false;
+            }
+
+            unsigned int unChannels = m_sConfig.unChannels;
+            while (nInputFrames > 0) {
+                size_t nFrames = nInputFrames < m_sConfig.unBlockFrames ? nInputFrames : m_sConfig.unBlockFrames;
+                nOutputFrames += ProcessBlock(pInput, nFrames, pOutput + nOutputFrames * unChannels);
+                pInput += nFrames * unChannels;
+                nInputFrames -= nFrames;
+            }
+            return true;
+        }
+
+        /**
+         * Resamples audio data.
+         * @param src Input at unInputSamplingRate, in either sample format. Samples of all channels are interleaved.
+         * @param dst eAudioDataSampleFormat, ucBuffer and unBufferSize (capacity in bytes) must be set. unAudioDataSamplingRate
+         *   is set to unOutputSamplingRate, unAudioDataSampleCount to the number of samples written and unBufferSize to
+         *   the number of bytes written.
+         * @return false if the sampling rate of src differs from the configuration, dst is too small, or construction could
+         *   not allocate its memory.
+         */
+        bool Process(const SAudioData& src, SAudioData& dst) {
+            if (m_pHistory == nullptr || src.unAudioDataSamplingRate != m_sConfig.unInputSamplingRate) {
+                return false;
+            }
+
+            unsigned int unChannels = m_sConfig.unChannels;
+            size_t nInputFrames = src.unBufferSize / BytesPerSample(src.eAudioDataSampleFormat) / unChannels;
+            size_t nCapacity = dst.unBufferSize / BytesPerSample(dst.eAudioDataSampleFormat) / unChannels;
+            if (nCapacity < GetMaxOutputFrames(nInputFrames)) {
+                return false;
+            }
+
+            bool bFloatInput = src.eAudioDataSampleFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32;
+            bool bFloatOutput = dst.eAudioDataSampleFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32;
+            size_t nInputOffset = 0;
+            size_t nOutputFrames = 0;
+            while (nInputOffset < nInputFrames) {
+                size_t nFrames = nInputFrames - nInputOffset;
+                nFrames = nFrames < m_sConfig.unBlockFrames ? nFrames : m_sConfig.unBlockFrames;
+
+                const float* pInput = m_pInputScratch;
+                if (bFloatInput) {
+                    pInput = reinterpret_cast<const float*>(src.ucBuffer) + nInputOffset * unChannels;
+                }
+                else {
+                    AudioSampleConverter::Int16ToFloat(reinterpret_cast<const int16_t*>(src.ucBuffer) + nInputOffset * unChannels, m_pInputScratch, nFrames * unChannels);
+                }
+
+                if (bFloatOutput) {
+                    nOutputFrames += ProcessBlock(pInput, nFrames, reinterpret_cast<float*>(dst.ucBuffer) + nOutputFrames * unChannels);
+                }
+                else {
+                    size_t nBlockOutput = ProcessBlock(pInput, nFrames, m_pOutputScratch);
+                    AudioSampleConverter::FloatToInt16(m_pOutputScratch, reinterpret_cast<int16_t*>(dst.ucBuffer) + nOutputFrames * unChannels, nBlockOutput * unChannels);
+                    nOutputFrames += nBlockOutput;
+                }
+                nInputOffset += nFrames;
+            }
+
+            dst.unAudioDataSamplingRate = m_sConfig.unOutputSamplingRate;
+            dst.unAudioDataSampleCount = (unsigned int)(nOutputFrames * unChannels);
+            dst.unBufferSize = (unsigned int)(nOutputFrames * unChannels * BytesPerSample(dst.eAudioDataSampleFormat));
+            return true;
+        }
+
+    private:
+        static unsigned int Gcd(unsigned int a, unsigned int b) {
+            while (b != 0) {
+                unsigned int r = a % b;
+                a = b;
+                b = r;
+            }
+            return a;
+        }
+
+        static size_t RoundUp8(size_t n) {
+            return (n + 7) & ~(size_t)7;
+        }
+
+        static unsigned int BytesPerSample(EAudioDataSampleType eFormat) {
+            return eFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 ? 4 : 2;
+        }
+
+        void FreeBuffers() {
+            float** ppBuffers[] = { &m_pOutputScratch, &m_pInputScratch, &m_pHistory, &m_pCoefficients };
+            for (float** ppBuffer : ppBuffers) {
+                if (*ppBuffer) {
+                    PlanetKitMemory::FreeAlignedMemory(*ppBuffer);
+                    *ppBuffer = nullptr;
+                }
+            }
+        }
+
+        static double BesselI0(double x) {
+            double dSum = 1.0;
+            double dTerm = 1.0;
+            for (int k = 1; k < 64; ++k) {
+                dTerm *= (x / (2.0 * k)) * (x / (2.0 * k));
+                dSum += dTerm;
+                if (dTerm < dSum * 1e-12) {
+                    break;
+                }
+            }
+            return dSum;
+        }
+
+        /**
+         * Designs the prototype low-pass filter at unPhaseCount times the input rate and stores each phase reversed,
+         * so that an output sample is a forward dot product with the input history. The extra phase of an approximated
+         * ratio is phase 0 advanced by one input sample, evaluated over the same history.
+         */
+        void DesignFilter(unsigned int unBaseTaps) {
+            const double dPi = 3.14159265358979323846;
+            double dAttenuation = m_sConfig.unStopbandDb > 21 ? m_sConfig.unStopbandDb : 21;
+            double dBeta = dAttenuation > 50 ? 0.1102 * (dAttenuation - 8.7) : 0.5842 * pow(dAttenuation - 21, 0.4) + 0.07886 * (dAttenuation - 21);
+
+            // Cutoff in cycles per sample of the lower rate, placed so the stopband starts at its Nyquist frequency.
+            double dTransition = (dAttenuation - 7.95) / (14.36 * unBaseTaps);
+            double dCutoff = 0.5 - dTransition / 2;
+            if (dCutoff < 0.05) {
+                dCutoff = 0.05;
+            }
+            if (m_unDown > m_unUp) {
+                dCutoff *= (double)m_unUp / m_unDown;
+            }
+            dCutoff /= m_unPhaseCount;
+
+            size_t nLength = m_nTaps * m_unPhaseCount;
+            double dCenter = (nLength - 1) / 2.0;
+            double dWindowScale = 1.0 / BesselI0(dBeta);
+            for (unsigned int unPhase = 0; unPhase < m_unFilterCount; ++unPhase) {
+                float* pPhase = m_pCoefficients + unPhase * m_nTaps;
+                double dSum = 0;
+                for (size_t j = 0; j < m_nTaps; ++j) {
+                    double k = (double)(unPhase + j * m_unPhaseCount);
+                    double t = k - dCenter;
+                    double dSinc = t == 0 ? 2 * dCutoff : sin(2 * dPi * dCutoff * t) / (dPi * t);
+                    double r = 2 * k / (nLength - 1) - 1;
+                    double dWindow = BesselI0(dBeta * sqrt(r * r < 1 ? 1 - r * r : 0)) * dWindowScale;
+                    pPhase[m_nTaps - 1 - j] = (float)(dSinc * dWindow);
+                    dSum += dSinc * dWindow;
+                }
+                // Every phase passes DC at unity gain, so a constant input never gets a ripple at the phase rate.
+                for (size_t j = 0; j < m_nTaps; ++j) {
+                    pPhase[j] = (float)(pPhase[j] / dSum);
+                }
+            }
+        }
+
+        /**
+         * Resamples at most unBlockFrames frames.
+         * @return Number of frames written to pOutput
+         */
+        size_t ProcessBlock(const float* pInput, size_t nFrames, float* pOutput) {
+            unsigned int unChannels = m_sConfig.unChannels;
+            size_t nKeep = m_nTaps - 1;
+
+            if (unChannels == 1) {
+                memcpy(m_pHistory + nKeep, pInput, nFrames * sizeof(float));
+            }
+            else {
+                float* ppChannels[PLNK_AUDIO_RESAMPLER_MAX_CHANNELS];
+                for (unsigned int c = 0; c < unChannels; ++c) {
+                    ppChannels[c] = m_pHistory + c * m_nHistoryStride + nKeep;
+                }
+                AudioSampleConverter::Deinterleave(pInput, unChannels, nFrames, ppChannels);
+            }
+
+            EAudioSimdLevel eLevel = AudioSampleConverter::GetSimdLevel();
+            size_t nEnd = nKeep + nFrames;
+            size_t nPosition = m_nPosition;
+            size_t nOutput = 0;
+            if (m_unUp == 1) {
+                // Integer decimation: a single phase and a whole step
+                for (; nPosition < nEnd; nPosition += m_unStepWhole, ++nOutput) {
+                    for (unsigned int c = 0; c < unChannels; ++c) {
+                        pOutput[nOutput * unChannels + c] = DotProduct(eLevel, m_pHistory + c * m_nHistoryStride + nPosition - nKeep, m_pCoefficients, m_nTaps);
+                    }
+                }
+            }
+            else {
+                unsigned int unPhase = m_unPhase;
+                for (; nPosition < nEnd; ++nOutput) {
+                    unsigned int unFilter = m_unPhaseCount == m_unUp ? unPhase : (unsigned int)(((uint64_t)unPhase * m_unPhaseCount + m_unUp / 2) / m_unUp);
+                    const float* pCoefficients = m_pCoefficients + unFilter * m_nTaps;
+                    for (unsigned int c = 0; c < unChannels; ++c) {
+                        pOutput[nOutput * unChannels + c] = DotProduct(eLevel, m_pHistory + c * m_nHistoryStride + nPosition - nKeep, pCoefficients, m_nTaps);
+                    }
+
+                    nPosition += m_unStepWhole;
+                    unPhase += m_unStepFraction;
+                    if (unPhase >= m_unUp) {
+                        unPhase -= m_unUp;
+                        ++nPosition;
+                    }
+                }
+                m_unPhase = unPhase;
+            }
+            m_nPosition = nPosition - nFrames;
+
+            for (unsigned int c = 0; c < unChannels; ++c) {
+                float* pHistory = m_pHistory + c * m_nHistoryStride;
+                memmove(pHistory, pHistory + nFrames, nKeep * sizeof(float));
+            }
+            return nOutput;
+        }
+
+        /**
+         * Dot product of nCount floats. nCount is a multiple of 8.
+         */
+        static float DotProduct(EAudioSimdLevel eLevel, const float* pSamples, const float* pCoefficients, size_t nCount) {
+            switch (eLevel) {
+#ifdef PLNK_AUDIO_SIMD_AVX2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                return DotProductAvx2(pSamples, pCoefficients, nCount);
+#endif
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                return DotProductSse2(pSamples, pCoefficients, nCount);
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                return DotProductNeon(pSamples, pCoefficients, nCount);
+#endif
+            default:
+                break;
+            }
+
+            float fSum = 0;
+            for (size_t i = 0; i < nCount; ++i) {
+                fSum += pSamples[i] * pCoefficients[i];
+            }
+            return fSum;
+        }
+
+#ifdef PLNK_AUDIO_SIMD_SSE2
+        static float DotProductSse2(const float* pSamples, const float* pCoefficients, size_t nCount) {
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (size_t i = 0; i < nCount; i += 8) {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(pSamples + i), _mm_load_ps(pCoefficients + i)));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(pSamples + i + 4), _mm_load_ps(pCoefficients + i + 4)));
+            }
+            __m128 sum = _mm_add_ps(sum0, sum1);
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(sum);
+        }
+#endif
+
+#ifdef PLNK_AUDIO_SIMD_AVX2
+        PLNK_AUDIO_TARGET_AVX2 static float DotProductAvx2(const float* pSamples, const float* pCoefficients, size_t nCount) {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t i = 0; i < nCount; i += 8) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(pSamples + i), _mm256_load_ps(pCoefficients + i)));
+            }
+            __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+            half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+            half = _mm_add_ss(half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(half);
+        }
+#endif
+
+#ifdef PLNK_AUDIO_SIMD_NEON
+        static float DotProductNeon(const float* pSamples, const float* pCoefficients, size_t nCount) {
+            float32x4_t sum0 = vdupq_n_f32(0.0f);
+            float32x4_t sum1 = vdupq_n_f32(0.0f);
+            for (size_t i = 0; i < nCount; i += 8) {
+                sum0 = vmlaq_f32(sum0, vld1q_f32(pSamples + i), vld1q_f32(pCoefficients + i));
+                sum1 = vmlaq_f32(sum1, vld1q_f32(pSamples + i + 4), vld1q_f32(pCoefficients + i + 4));
+            }
+            return vaddvq_f32(vaddq_f32(sum0, sum1));
+        }
+#endif
+
+    private:
+        SAudioResamplerConfig m_sConfig;
+
+        unsigned int m_unUp = 1;
+        unsigned int m_unDown = 1;
+        unsigned int m_unStepWhole = 1;
+        unsigned int m_unStepFraction = 0;
+        unsigned int m_unPhaseCount = 1;
+        unsigned int m_unFilterCount = 1;
+        size_t m_nTaps = 8;
+
+        float* m_pCoefficients = nullptr;
+        float* m_pHistory = nullptr;
+        size_t m_nHistoryStride = 0;
+        float* m_pInputScratch = nullptr;
+        float* m_pOutputScratch = nullptr;
+
+        size_t m_nPosition = 0;
+        unsigned int m_unPhase = 0;
+    };
+};
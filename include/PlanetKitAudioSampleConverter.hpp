@@ -0,0 +1,686 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#include "PlanetKitAudioDefine.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLNK_AUDIO_SIMD_SSE2 1
+#define PLNK_AUDIO_SIMD_AVX2 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define PLNK_AUDIO_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PLNK_AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PLNK_AUDIO_TARGET_AVX2
+#endif
+
+namespace PlanetKit {
+    /**
+     * Instruction set used by AudioSampleConverter
+     */
+    typedef enum EAudioSimdLevel {
+        /// Portable scalar reference
+        PLNK_AUDIO_SIMD_LEVEL_SCALAR = 0,
+        /// SSE2, the baseline on x64
+        PLNK_AUDIO_SIMD_LEVEL_SSE2 = 1,
+        /// AVX2, chosen at run time on x86 processors that support it
+        PLNK_AUDIO_SIMD_LEVEL_AVX2 = 2,
+        /// NEON, the baseline on ARM64
+        PLNK_AUDIO_SIMD_LEVEL_NEON = 3,
+    } EAudioSimdLevel;
+
+    /**
+     * State of the TPDF dither noise generator. Keep one per stream.
+     */
+    typedef struct SAudioDitherState {
+        /// One xorshift32 generator per SIMD lane. None may be zero.
+        uint32_t unLanes[8];
+
+        explicit SAudioDitherState(uint32_t unSeed = 0x9E3779B9u) {
+            for (unsigned int i = 0; i < 8; ++i) {
+                unSeed = unSeed * 1664525u + 1013904223u;
+                unLanes[i] = unSeed ? unSeed : 1;
+            }
+        }
+    } SAudioDitherState;
+
+    /**
+     * Sample format conversion kernels for SAudioData and hooked audio.
+     * @remark
+     *   Every kernel has a scalar reference and SSE2, AVX2 or NEON versions. The fastest level supported by the processor is
+     *   selected on first use. SetSimdLevel can force a lower level, for example to compare against the scalar reference.<br>
+     *   Float samples use the range [-1.0, 1.0). Conversion to 16 bits scales by 32768, rounds to nearest even and saturates.
+     *   All levels give identical results, except that dither noise sequences differ between levels. NaN input gives 32767.
+     */
+    class AudioSampleConverter {
+    public:
+        /**
+         * Gets the level used by the kernels.
+         */
+        static EAudioSimdLevel GetSimdLevel() {
+            return (EAudioSimdLevel)ActiveLevel().load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Gets the best level supported by this processor.
+         */
+        static EAudioSimdLevel GetSupportedSimdLevel() {
+            static const EAudioSimdLevel s_eLevel = DetectLevel();
+            return s_eLevel;
+        }
+
+        /**
+         * Forces the level used by the kernels.
+         * @return false if the processor does not support eLevel.
+         */
+        static bool SetSimdLevel(EAudioSimdLevel eLevel) {
+            if (IsSupported(eLevel) == false) {
+                return false;
+            }
+            ActiveLevel().store(eLevel, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * Converts float samples to 16-bit samples with saturation.
+         */
+        static void FloatToInt16(const float* pSrc, int16_t* pDst, size_t nCount) {
+            size_t i = 0;
+            switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_AVX2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                i = FloatToInt16Avx2(pSrc, pDst, nCount);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                i = FloatToInt16Sse2(pSrc, pDst, nCount);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                i = FloatToInt16Neon(pSrc, pDst, nCount);
+                break;
+#endif
+            default:
+                break;
+            }
+
+            for (; i < nCount; ++i) {
+                pDst[i] = Saturate(pSrc[i] * 32768.0f);
+            }
+        }
+
+        /**
+         * Converts float samples to 16-bit samples with saturation and triangular (TPDF) dither of +-1 LSB.
+         * @param sState Noise generator state, updated by the call.
+         */
+        static void FloatToInt16Dithered(const float* pSrc, int16_t* pDst, size_t nCount, SAudioDitherState& sState) {
+            size_t i = 0;
+            switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_AVX2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                i = FloatToInt16DitheredAvx2(pSrc, pDst, nCount, sState);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                i = FloatToInt16DitheredSse2(pSrc, pDst, nCount, sState);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                i = FloatToInt16DitheredNeon(pSrc, pDst, nCount, sState);
+                break;
+#endif
+            default:
+                break;
+            }
+
+            for (; i < nCount; ++i) {
+                pDst[i] = Saturate(pSrc[i] * 32768.0f + Dither(sState.unLanes[0]));
+            }
+        }
+
+        /**
+         * Converts 16-bit samples to float samples.
+         */
+        static void Int16ToFloat(const int16_t* pSrc, float* pDst, size_t nCount) {
+            size_t i = 0;
+            switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_AVX2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                i = Int16ToFloatAvx2(pSrc, pDst, nCount);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                i = Int16ToFloatSse2(pSrc, pDst, nCount);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                i = Int16ToFloatNeon(pSrc, pDst, nCount);
+                break;
+#endif
+            default:
+                break;
+            }
+
+            for (; i < nCount; ++i) {
+                pDst[i] = pSrc[i] * (1.0f / 32768.0f);
+            }
+        }
+
+        /**
+         * Multiplies float samples by fGain in place.
+         */
+        static void ApplyGain(float* pSamples, size_t nCount, float fGain) {
+            size_t i = 0;
+            switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_AVX2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                i = ApplyGainAvx2(pSamples, nCount, fGain);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                i = ApplyGainSse2(pSamples, nCount, fGain);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                i = ApplyGainNeon(pSamples, nCount, fGain);
+                break;
+#endif
+            default:
+                break;
+            }
+
+            for (; i < nCount; ++i) {
+                pSamples[i] *= fGain;
+            }
+        }
+
+        /**
+         * Multiplies 16-bit samples by fGain in place with saturation.
+         */
+        static void ApplyGain(int16_t* pSamples, size_t nCount, float fGain) {
+            size_t i = 0;
+            switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                i = ApplyGainSse2(pSamples, nCount, fGain);
+                break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                i = ApplyGainNeon(pSamples, nCount, fGain);
+                break;
+#endif
+            default:
+                break;
+            }
+
+            for (; i < nCount; ++i) {
+                pSamples[i] = Saturate(pSamples[i] * fGain);
+            }
+        }
+
+        /**
+         * Interleaves planar float channels.
+         * @param ppSrc unChannels pointers to nFrames samples each
+         * @param pDst nFrames * unChannels samples
+         */
+        static void Interleave(const float* const* ppSrc, unsigned int unChannels, size_t nFrames, float* pDst) {
+            size_t i = 0;
+            if (unChannels == 2) {
+                switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_SSE2
+                case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                    i = InterleaveStereoSse2(ppSrc[0], ppSrc[1], nFrames, pDst);
+                    break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+                case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                    i = InterleaveStereoNeon(ppSrc[0], ppSrc[1], nFrames, pDst);
+                    break;
+#endif
+                default:
+                    break;
+                }
+            }
+
+            for (; i < nFrames; ++i) {
+                for (unsigned int c = 0; c < unChannels; ++c) {
+                    pDst[i * unChannels + c] = ppSrc[c][i];
+                }
+            }
+        }
+
+        /**
+         * Splits interleaved float samples into planar channels.
+         * @param pSrc nFrames * unChannels samples
+         * @param ppDst unChannels pointers to room for nFrames samples each
+         */
+        static void Deinterleave(const float* pSrc, unsigned int unChannels, size_t nFrames, float* const* ppDst) {
+            size_t i = 0;
+            if (unChannels == 2) {
+                switch (GetSimdLevel()) {
+#ifdef PLNK_AUDIO_SIMD_SSE2
+                case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                    i = DeinterleaveStereoSse2(pSrc, nFrames, ppDst[0], ppDst[1]);
+                    break;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+                case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                    i = DeinterleaveStereoNeon(pSrc, nFrames, ppDst[0], ppDst[1]);
+                    break;
+#endif
+                default:
+                    break;
+                }
+            }
+
+            for (; i < nFrames; ++i) {
+                for (unsigned int c = 0; c < unChannels; ++c) {
+                    ppDst[c][i] = pSrc[i * unChannels + c];
+                }
+            }
+        }
+
+        /**
+         * Converts audio data to the sample format of dst.
+         * @param src Source audio data.
+         * @param dst eAudioDataSampleFormat, ucBuffer and unBufferSize (capacity in bytes) must be set. The other fields are
+         *   copied from src and unBufferSize is set to the number of bytes written.
+         * @param pDither Dither state used for float to 16-bit conversion, or nullptr for no dither.
+         * @return false if dst is too small.
+         */
+        static bool Convert(const SAudioData& src, SAudioData& dst, SAudioDitherState* pDither = nullptr) {
+            size_t nCount = src.unBufferSize / BytesPerSample(src.eAudioDataSampleFormat);
+            size_t nBytes = nCount * BytesPerSample(dst.eAudioDataSampleFormat);
+            if (nBytes > dst.unBufferSize) {
+                return false;
+            }
+
+            if (src.eAudioDataSampleFormat == dst.eAudioDataSampleFormat) {
+                memmove(dst.ucBuffer, src.ucBuffer, nBytes);
+            }
+            else if (src.eAudioDataSampleFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32) {
+                const float* pSrc = reinterpret_cast<const float*>(src.ucBuffer);
+                int16_t* pDst = reinterpret_cast<int16_t*>(dst.ucBuffer);
+                if (pDither) {
+                    FloatToInt16Dithered(pSrc, pDst, nCount, *pDither);
+                }
+                else {
+                    FloatToInt16(pSrc, pDst, nCount);
+                }
+            }
+            else {
+                Int16ToFloat(reinterpret_cast<const int16_t*>(src.ucBuffer), reinterpret_cast<float*>(dst.ucBuffer), nCount);
+            }
+
+            dst.unAudioDataSamplingRate = src.unAudioDataSamplingRate;
+            dst.unAudioDataSampleCount = src.unAudioDataSampleCount;
+            dst.unBufferSize = (unsigned int)nBytes;
+            return true;
+        }
+
+    private:
+        static unsigned int BytesPerSample(EAudioDataSampleType eFormat) {
+            return eFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 ? 4 : 2;
+        }
+
+        static std::atomic<int>& ActiveLevel() {
+            static std::atomic<int> s_nLevel(GetSupportedSimdLevel());
+            return s_nLevel;
+        }
+
+        static bool IsSupported(EAudioSimdLevel eLevel) {
+            switch (eLevel) {
+            case PLNK_AUDIO_SIMD_LEVEL_SCALAR:
+                return true;
+#ifdef PLNK_AUDIO_SIMD_SSE2
+            case PLNK_AUDIO_SIMD_LEVEL_SSE2:
+                return true;
+            case PLNK_AUDIO_SIMD_LEVEL_AVX2:
+                return GetSupportedSimdLevel() == PLNK_AUDIO_SIMD_LEVEL_AVX2;
+#endif
+#ifdef PLNK_AUDIO_SIMD_NEON
+            case PLNK_AUDIO_SIMD_LEVEL_NEON:
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        static EAudioSimdLevel DetectLevel() {
+#if defined(PLNK_AUDIO_SIMD_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] >= 7) {
+                __cpuid(info, 1);
+                bool bOsAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+                __cpuidex(info, 7, 0);
+                if (bOsAvx && (info[1] & (1 << 5)) != 0) {
+                    return PLNK_AUDIO_SIMD_LEVEL_AVX2;
+                }
+            }
+            return PLNK_AUDIO_SIMD_LEVEL_SSE2;
+#elif defined(PLNK_AUDIO_SIMD_AVX2)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? PLNK_AUDIO_SIMD_LEVEL_AVX2 : PLNK_AUDIO_SIMD_LEVEL_SSE2;
+#elif defined(PLNK_AUDIO_SIMD_NEON)
+            return PLNK_AUDIO_SIMD_LEVEL_NEON;
+#else
+            return PLNK_AUDIO_SIMD_LEVEL_SCALAR;
+#endif
+        }
+
+        static int16_t Saturate(float fValue) {
+            // Written so that NaN saturates to the maximum, as the SSE2 min/max do.
+            fValue = fValue < 32767.0f ? fValue : 32767.0f;
+            fValue = fValue > -32768.0f ? fValue : -32768.0f;
+            return (int16_t)lrintf(fValue);
+        }
+
+        /**
+         * Steps a xorshift32 generator and turns it into triangular noise in (-1, 1): the sum of its signed 16-bit halves.
+         */
+        static float Dither(uint32_t& unState) {
+            unState ^= unState << 13;
+            unState ^= unState >> 17;
+            unState ^= unState << 5;
+            return ((int32_t)(int16_t)(unState & 0xFFFF) + (int32_t)(int16_t)(unState >> 16)) * (1.0f / 65536.0f);
+        }
+
+#ifdef PLNK_AUDIO_SIMD_SSE2
+        static __m128i DitherSse2(__m128i& state) {
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+            state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+            return _mm_add_epi32(_mm_srai_epi32(_mm_slli_epi32(state, 16), 16), _mm_srai_epi32(state, 16));
+        }
+
+        static __m128i ScaleAndRoundSse2(__m128 samples, __m128 noise) {
+            __m128 scaled = _mm_add_ps(_mm_mul_ps(samples, _mm_set1_ps(32768.0f)), noise);
+            scaled = _mm_max_ps(_mm_min_ps(scaled, _mm_set1_ps(32767.0f)), _mm_set1_ps(-32768.0f));
+            return _mm_cvtps_epi32(scaled);
+        }
+
+        static size_t FloatToInt16Sse2(const float* pSrc, int16_t* pDst, size_t nCount) {
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                __m128i lo = ScaleAndRoundSse2(_mm_loadu_ps(pSrc + i), _mm_setzero_ps());
+                __m128i hi = ScaleAndRoundSse2(_mm_loadu_ps(pSrc + i + 4), _mm_setzero_ps());
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(lo, hi));
+            }
+            return i;
+        }
+
+        static size_t FloatToInt16DitheredSse2(const float* pSrc, int16_t* pDst, size_t nCount, SAudioDitherState& sState) {
+            __m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sState.unLanes));
+            __m128 scale = _mm_set1_ps(1.0f / 65536.0f);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                __m128i lo = ScaleAndRoundSse2(_mm_loadu_ps(pSrc + i), _mm_mul_ps(_mm_cvtepi32_ps(DitherSse2(state)), scale));
+                __m128i hi = ScaleAndRoundSse2(_mm_loadu_ps(pSrc + i + 4), _mm_mul_ps(_mm_cvtepi32_ps(DitherSse2(state)), scale));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i), _mm_packs_epi32(lo, hi));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sState.unLanes), state);
+            return i;
+        }
+
+        static size_t Int16ToFloatSse2(const int16_t* pSrc, float* pDst, size_t nCount) {
+            __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+                __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+                __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+                _mm_storeu_ps(pDst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+                _mm_storeu_ps(pDst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+            }
+            return i;
+        }
+
+        static size_t ApplyGainSse2(float* pSamples, size_t nCount, float fGain) {
+            __m128 gain = _mm_set1_ps(fGain);
+            size_t i = 0;
+            for (; i + 4 <= nCount; i += 4) {
+                _mm_storeu_ps(pSamples + i, _mm_mul_ps(_mm_loadu_ps(pSamples + i), gain));
+            }
+            return i;
+        }
+
+        static size_t ApplyGainSse2(int16_t* pSamples, size_t nCount, float fGain) {
+            __m128 gain = _mm_set1_ps(fGain);
+            __m128 maximum = _mm_set1_ps(32767.0f);
+            __m128 minimum = _mm_set1_ps(-32768.0f);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSamples + i));
+                __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16)), gain);
+                __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16)), gain);
+                lo = _mm_max_ps(_mm_min_ps(lo, maximum), minimum);
+                hi = _mm_max_ps(_mm_min_ps(hi, maximum), minimum);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pSamples + i), _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+            }
+            return i;
+        }
+
+        static size_t InterleaveStereoSse2(const float* pLeft, const float* pRight, size_t nFrames, float* pDst) {
+            size_t i = 0;
+            for (; i + 4 <= nFrames; i += 4) {
+                __m128 left = _mm_loadu_ps(pLeft + i);
+                __m128 right = _mm_loadu_ps(pRight + i);
+                _mm_storeu_ps(pDst + i * 2, _mm_unpacklo_ps(left, right));
+                _mm_storeu_ps(pDst + i * 2 + 4, _mm_unpackhi_ps(left, right));
+            }
+            return i;
+        }
+
+        static size_t DeinterleaveStereoSse2(const float* pSrc, size_t nFrames, float* pLeft, float* pRight) {
+            size_t i = 0;
+            for (; i + 4 <= nFrames; i += 4) {
+                __m128 a = _mm_loadu_ps(pSrc + i * 2);
+                __m128 b = _mm_loadu_ps(pSrc + i * 2 + 4);
+                _mm_storeu_ps(pLeft + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_ps(pRight + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+            return i;
+        }
+#endif
+
+#ifdef PLNK_AUDIO_SIMD_AVX2
+        PLNK_AUDIO_TARGET_AVX2 static __m256i DitherAvx2(__m256i& state) {
+            state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+            state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+            state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+            return _mm256_add_epi32(_mm256_srai_epi32(_mm256_slli_epi32(state, 16), 16), _mm256_srai_epi32(state, 16));
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static __m256i ScaleAndRoundAvx2(__m256 samples, __m256 noise) {
+            __m256 scaled = _mm256_add_ps(_mm256_mul_ps(samples, _mm256_set1_ps(32768.0f)), noise);
+            scaled = _mm256_max_ps(_mm256_min_ps(scaled, _mm256_set1_ps(32767.0f)), _mm256_set1_ps(-32768.0f));
+            return _mm256_cvtps_epi32(scaled);
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static void StorePackedAvx2(int16_t* pDst, __m256i lo, __m256i hi) {
+            // packs works per 128-bit lane, so the 64-bit quarters are put back in order afterwards.
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst), packed);
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static size_t FloatToInt16Avx2(const float* pSrc, int16_t* pDst, size_t nCount) {
+            size_t i = 0;
+            for (; i + 16 <= nCount; i += 16) {
+                __m256i lo = ScaleAndRoundAvx2(_mm256_loadu_ps(pSrc + i), _mm256_setzero_ps());
+                __m256i hi = ScaleAndRoundAvx2(_mm256_loadu_ps(pSrc + i + 8), _mm256_setzero_ps());
+                StorePackedAvx2(pDst + i, lo, hi);
+            }
+            return i;
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static size_t FloatToInt16DitheredAvx2(const float* pSrc, int16_t* pDst, size_t nCount, SAudioDitherState& sState) {
+            __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sState.unLanes));
+            __m256 scale = _mm256_set1_ps(1.0f / 65536.0f);
+            size_t i = 0;
+            for (; i + 16 <= nCount; i += 16) {
+                __m256i lo = ScaleAndRoundAvx2(_mm256_loadu_ps(pSrc + i), _mm256_mul_ps(_mm256_cvtepi32_ps(DitherAvx2(state)), scale));
+                __m256i hi = ScaleAndRoundAvx2(_mm256_loadu_ps(pSrc + i + 8), _mm256_mul_ps(_mm256_cvtepi32_ps(DitherAvx2(state)), scale));
+                StorePackedAvx2(pDst + i, lo, hi);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(sState.unLanes), state);
+            return i;
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static size_t Int16ToFloatAvx2(const int16_t* pSrc, float* pDst, size_t nCount) {
+            __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i)));
+                _mm256_storeu_ps(pDst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+            }
+            return i;
+        }
+
+        PLNK_AUDIO_TARGET_AVX2 static size_t ApplyGainAvx2(float* pSamples, size_t nCount, float fGain) {
+            __m256 gain = _mm256_set1_ps(fGain);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                _mm256_storeu_ps(pSamples + i, _mm256_mul_ps(_mm256_loadu_ps(pSamples + i), gain));
+            }
+            return i;
+        }
+#endif
+
+#ifdef PLNK_AUDIO_SIMD_NEON
+        static int32x4_t DitherNeon(uint32x4_t& state) {
+            state = veorq_u32(state, vshlq_n_u32(state, 13));
+            state = veorq_u32(state, vshrq_n_u32(state, 17));
+            state = veorq_u32(state, vshlq_n_u32(state, 5));
+            int32x4_t value = vreinterpretq_s32_u32(state);
+            return vaddq_s32(vshrq_n_s32(vshlq_n_s32(value, 16), 16), vshrq_n_s32(value, 16));
+        }
+
+        static int32x4_t ScaleAndRoundNeon(float32x4_t samples, float32x4_t noise) {
+            float32x4_t scaled = vaddq_f32(vmulq_n_f32(samples, 32768.0f), noise);
+            float32x4_t maximum = vdupq_n_f32(32767.0f);
+            // vminq/vmaxq would pass NaN through and convert it to 0. Select the maximum for NaN, as SSE2 and the scalar code do.
+            float32x4_t clamped = vmaxnmq_f32(vminnmq_f32(scaled, maximum), vdupq_n_f32(-32768.0f));
+            return vcvtnq_s32_f32(vbslq_f32(vceqq_f32(scaled, scaled), clamped, maximum));
+        }
+
+        static size_t FloatToInt16Neon(const float* pSrc, int16_t* pDst, size_t nCount) {
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                int32x4_t lo = ScaleAndRoundNeon(vld1q_f32(pSrc + i), vdupq_n_f32(0.0f));
+                int32x4_t hi = ScaleAndRoundNeon(vld1q_f32(pSrc + i + 4), vdupq_n_f32(0.0f));
+                vst1q_s16(pDst + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+            }
+            return i;
+        }
+
+        static size_t FloatToInt16DitheredNeon(const float* pSrc, int16_t* pDst, size_t nCount, SAudioDitherState& sState) {
+            uint32x4_t state = vld1q_u32(sState.unLanes);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                int32x4_t lo = ScaleAndRoundNeon(vld1q_f32(pSrc + i), vmulq_n_f32(vcvtq_f32_s32(DitherNeon(state)), 1.0f / 65536.0f));
+                int32x4_t hi = ScaleAndRoundNeon(vld1q_f32(pSrc + i + 4), vmulq_n_f32(vcvtq_f32_s32(DitherNeon(state)), 1.0f / 65536.0f));
+                vst1q_s16(pDst + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+            }
+            vst1q_u32(sState.unLanes, state);
+            return i;
+        }
+
+        static size_t Int16ToFloatNeon(const int16_t* pSrc, float* pDst, size_t nCount) {
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                int16x8_t samples = vld1q_s16(pSrc + i);
+                vst1q_f32(pDst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), 1.0f / 32768.0f));
+                vst1q_f32(pDst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), 1.0f / 32768.0f));
+            }
+            return i;
+        }
+
+        static size_t ApplyGainNeon(float* pSamples, size_t nCount, float fGain) {
+            size_t i = 0;
+            for (; i + 4 <= nCount; i += 4) {
+                vst1q_f32(pSamples + i, vmulq_n_f32(vld1q_f32(pSamples + i), fGain));
+            }
+            return i;
+        }
+
+        static size_t ApplyGainNeon(int16_t* pSamples, size_t nCount, float fGain) {
+            float32x4_t maximum = vdupq_n_f32(32767.0f);
+            float32x4_t minimum = vdupq_n_f32(-32768.0f);
+            size_t i = 0;
+            for (; i + 8 <= nCount; i += 8) {
+                int16x8_t samples = vld1q_s16(pSamples + i);
+                float32x4_t lo = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), fGain);
+                float32x4_t hi = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), fGain);
+                lo = vmaxq_f32(vminq_f32(lo, maximum), minimum);
+                hi = vmaxq_f32(vminq_f32(hi, maximum), minimum);
+                vst1q_s16(pSamples + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi))));
+            }
+            return i;
+        }
+
+        static size_t InterleaveStereoNeon(const float* pLeft, const float* pRight, size_t nFrames, float* pDst) {
+            size_t i = 0;
+            for (; i + 4 <= nFrames; i += 4) {
+                float32x4x2_t frames;
+                frames.val[0] = vld1q_f32(pLeft + i);
+                frames.val[1] = vld1q_f32(pRight + i);
+                vst2q_f32(pDst + i * 2, frames);
+            }
+            return i;
+        }
+
+        static size_t DeinterleaveStereoNeon(const float* pSrc, size_t nFrames, float* pLeft, float* pRight) {
+            size_t i = 0;
+            for (; i + 4 <= nFrames; i += 4) {
+                float32x4x2_t frames = vld2q_f32(pSrc + i * 2);
+                vst1q_f32(pLeft + i, frames.val[0]);
+                vst1q_f32(pRight + i, frames.val[1]);
+            }
+            return i;
+        }
+#endif
+    };
+};
@@ -53,6 +53,16 @@ namespace PlanetKit
             }
         }
 
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+        /**
+         * Takes over the reference held by src without touching the reference count.
+         */
+        AutoPtr(AutoPtr<T>&& src) {
+            this->m_pData = src.m_pData;
+            src.m_pData = nullptr;
+        }
+#endif
+
         virtual ~AutoPtr() {
             Release();
         }
@@ -90,6 +100,22 @@ namespace PlanetKit
             return *this;
         }
 
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+        /**
+         * Takes over the reference held by src without touching the reference count.
+         */
+        AutoPtr<T>& operator=(AutoPtr<T>&& src) {
+            if (this != &src) {
+                Release();
+
+                this->m_pData = src.m_pData;
+                src.m_pData = nullptr;
+            }
+
+            return *this;
+        }
+#endif
+
         /**
          * Sets a value.
          */
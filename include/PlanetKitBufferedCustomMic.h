@@ -0,0 +1,351 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "PlanetKitCustomMic.h"
+
+#if defined(_WIN32)
+#include <mmsystem.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "winmm.lib")
+#endif
+#endif
+
+namespace PlanetKit {
+    /**
+     * What BufferedCustomMic does when a frame is queued faster than it is delivered.
+     */
+    typedef enum EBufferedMicOverflowPolicy {
+        /// Rejects the incoming frame once the queue holds unDepth frames.
+        PLNK_BUFFERED_MIC_OVERFLOW_DROP_NEWEST = 0,
+        /// Keeps the incoming frame. Before each delivery the delivery thread discards the oldest frames beyond unDepth,
+        /// so latency stays bounded. Frames are only rejected if a burst exceeds twice unDepth between two deliveries.
+        PLNK_BUFFERED_MIC_OVERFLOW_DROP_OLDEST = 1,
+    } EBufferedMicOverflowPolicy;
+
+    /**
+     * What BufferedCustomMic does when no frame is queued at delivery time.
+     */
+    typedef enum EBufferedMicUnderflowPolicy {
+        /// Delivers nothing for this period.
+        PLNK_BUFFERED_MIC_UNDERFLOW_SKIP = 0,
+        /// Delivers a silent frame in the format of the last delivered frame, so the session sees a steady cadence.
+        PLNK_BUFFERED_MIC_UNDERFLOW_SILENCE = 1,
+    } EBufferedMicUnderflowPolicy;
+
+    /**
+     * Configuration of BufferedCustomMic
+     */
+    typedef struct SBufferedMicConfig {
+        /// Number of frames the queue holds before the overflow policy applies
+        unsigned int unDepth = 8;
+        /// Number of frames queued before delivery starts, and again after each underflow
+        unsigned int unPrefillFrames = 2;
+        /// Largest frame in bytes. Every queue slot is allocated with this size up front. The default fits 10 ms of 48 kHz stereo float samples.
+        unsigned int unMaxFrameBytes = 48000 / 100 * 2 * sizeof(float);
+        /// Delivery period in milliseconds until the first frame tells the actual one
+        unsigned int unDefaultFrameMs = 10;
+        /// Overflow policy
+        EBufferedMicOverflowPolicy eOverflowPolicy = PLNK_BUFFERED_MIC_OVERFLOW_DROP_NEWEST;
+        /// Underflow policy
+        EBufferedMicUnderflowPolicy eUnderflowPolicy = PLNK_BUFFERED_MIC_UNDERFLOW_SKIP;
+    } SBufferedMicConfig;
+
+    /**
+     * Counters of BufferedCustomMic
+     */
+    typedef struct SBufferedMicStatistics {
+        /// Frames accepted by EnqueueAudioData
+        uint64_t ullEnqueuedFrames;
+        /// Frames delivered to the session, not counting silence
+        uint64_t ullDeliveredFrames;
+        /// Frames rejected or discarded by the overflow policy
+        uint64_t ullOverflowFrames;
+        /// Frames rejected by EnqueueAudioData because they are larger than SBufferedMicConfig::unMaxFrameBytes
+        uint64_t ullRejectedFrames;
+        /// Delivery periods without a queued frame
+        uint64_t ullUnderflows;
+        /// Frames currently queued
+        unsigned int unFillLevel;
+    } SBufferedMicStatistics;
+
+    /**
+     * Custom microphone that decouples the application's audio producer from the session.
+     * @remark
+     *   The producer calls EnqueueAudioData from a single thread. The frame is copied into a preallocated slot of a
+     *   single-producer/single-consumer ring, which never blocks, locks or allocates.<br>
+     *   A delivery thread started by Start() takes frames from the ring at real-time cadence, derived from each frame's
+     *   sample count and sampling rate, and passes them to CustomMic::PutAudioData. Jitter on either side is absorbed by
+     *   the queue instead of stalling the other side.<br>
+     *   Do not call PutAudioData directly while the delivery thread is running.<br>
+     *   If the slots cannot be allocated, Start() and EnqueueAudioData() return false.<br>
+     *   On Windows the delivery thread raises the system timer resolution to 1 ms while it runs, because the default
+     *   resolution of about 15.6 ms is longer than a typical 10 ms frame. MinGW builds have to link winmm.
+     */
+    class BufferedCustomMic : public CustomMic {
+    public:
+        explicit BufferedCustomMic(const SBufferedMicConfig& sConfig = SBufferedMicConfig()) : m_sConfig(sConfig) {
+            if (m_sConfig.unDepth == 0) {
+                m_sConfig.unDepth = 1;
+            }
+            if (m_sConfig.unPrefillFrames > m_sConfig.unDepth) {
+                m_sConfig.unPrefillFrames = m_sConfig.unDepth;
+            }
+
+            // Room for one burst of unDepth frames on top of a full queue, so that DROP_OLDEST can keep the newest frames.
+            m_unSlotCount = m_sConfig.eOverflowPolicy == PLNK_BUFFERED_MIC_OVERFLOW_DROP_OLDEST ? m_sConfig.unDepth * 2 : m_sConfig.unDepth;
+
+            m_sSilence.unAudioDataSamplingRate = 0;
+            m_sSilence.unAudioDataSampleCount = 0;
+            m_sSilence.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+            m_sSilence.ucBuffer = nullptr;
+            m_sSilence.unBufferSize = 0;
+
+            if (m_unSlotCount > SIZE_MAX / sizeof(SAudioData) ||
+                (m_sConfig.unMaxFrameBytes > 0 && (size_t)m_unSlotCount + 1 > SIZE_MAX / m_sConfig.unMaxFrameBytes)) {
+                m_unSlotCount = 0;
+                return;
+            }
+
+            m_pSlots = static_cast<SAudioData*>(PlanetKitMemory::AllocateArrayMemory(m_unSlotCount * sizeof(SAudioData)));
+            m_pSlotBuffer = static_cast<unsigned char*>(PlanetKitMemory::AllocateArrayMemory(((size_t)m_unSlotCount + 1) * m_sConfig.unMaxFrameBytes));
+            if (m_pSlots == nullptr || m_pSlotBuffer == nullptr) {
+                if (m_pSlots) {
+                    PlanetKitMemory::FreeArrayMemory(m_pSlots);
+                    m_pSlots = nullptr;
+                }
+                if (m_pSlotBuffer) {
+                    PlanetKitMemory::FreeArrayMemory(m_pSlotBuffer);
+                    m_pSlotBuffer = nullptr;
+                }
+                m_unSlotCount = 0;
+                return;
+            }
+
+            for (unsigned int i = 0; i < m_unSlotCount; ++i) {
+                m_pSlots[i].ucBuffer = m_pSlotBuffer + (size_t)i * m_sConfig.unMaxFrameBytes;
+            }
+
+            // The last buffer holds the silence delivered on underflow.
+            m_sSilence.ucBuffer = m_pSlotBuffer + (size_t)m_unSlotCount * m_sConfig.unMaxFrameBytes;
+            memset(m_sSilence.ucBuffer, 0, m_sConfig.unMaxFrameBytes);
+        }
+
+        BufferedCustomMic(const BufferedCustomMic&) = delete;
+        BufferedCustomMic& operator=(const BufferedCustomMic&) = delete;
+
+        virtual ~BufferedCustomMic() {
+            Stop();
+
+            if (m_pSlotBuffer) {
+                PlanetKitMemory::FreeArrayMemory(m_pSlotBuffer);
+            }
+            if (m_pSlots) {
+                PlanetKitMemory::FreeArrayMemory(m_pSlots);
+            }
+        }
+
+        /**
+         * Starts the delivery thread.
+         * @return false if it is already running or the slots could not be allocated.
+         */
+        bool Start() {
+            if (m_thread.joinable() || m_pSlots == nullptr) {
+                return false;
+            }
+
+            m_bStop.store(false, std::memory_order_relaxed);
+            m_thread = std::thread(&BufferedCustomMic::DeliveryLoop, this);
+            return true;
+        }
+
+        /**
+         * Stops the delivery thread. Frames still queued stay queued.
+         */
+        void Stop() {
+            if (m_thread.joinable()) {
+                m_bStop.store(true, std::memory_order_relaxed);
+                m_thread.join();
+            }
+        }
+
+        /**
+         * Queues a copy of audio data for delivery.
+         * @param audioData Audio data. unBufferSize bytes are copied from ucBuffer.
+         * @return false if the frame was rejected by the overflow policy, is larger than SBufferedMicConfig::unMaxFrameBytes,
+         *   or the slots could not be allocated.
+         * @remark Must always be called from the same thread.
+         */
+        bool EnqueueAudioData(const SAudioData& audioData) {
+            if (m_pSlots == nullptr) {
+                return false;
+            }
+
+            if (audioData.unBufferSize > m_sConfig.unMaxFrameBytes) {
+                m_ullRejectedFrames.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            uint64_t ullWrite = m_ullWrite.load(std::memory_order_relaxed);
+            if (ullWrite - m_ullRead.load(std::memory_order_acquire) >= m_unSlotCount) {
+                m_ullOverflowFrames.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            SAudioData& slot = m_pSlots[ullWrite % m_unSlotCount];
+            slot.unAudioDataSamplingRate = audioData.unAudioDataSamplingRate;
+            slot.unAudioDataSampleCount = audioData.unAudioDataSampleCount;
+            slot.eAudioDataSampleFormat = audioData.eAudioDataSampleFormat;
+            slot.unBufferSize = audioData.unBufferSize;
+            memcpy(slot.ucBuffer, audioData.ucBuffer, audioData.unBufferSize);
+
+            m_ullWrite.store(ullWrite + 1, std::memory_order_release);
+            m_ullEnqueuedFrames.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * Gets a snapshot of the counters. Can be called from any thread.
+         */
+        void GetStatistics(SBufferedMicStatistics& sStatistics) const {
+            sStatistics.ullEnqueuedFrames = m_ullEnqueuedFrames.load(std::memory_order_relaxed);
+            sStatistics.ullDeliveredFrames = m_ullDeliveredFrames.load(std::memory_order_relaxed);
+            sStatistics.ullOverflowFrames = m_ullOverflowFrames.load(std::memory_order_relaxed);
+            sStatistics.ullRejectedFrames = m_ullRejectedFrames.load(std::memory_order_relaxed);
+            sStatistics.ullUnderflows = m_ullUnderflows.load(std::memory_order_relaxed);
+            sStatistics.unFillLevel = (unsigned int)(m_ullWrite.load(std::memory_order_acquire) - m_ullRead.load(std::memory_order_acquire));
+        }
+
+    private:
+        void DeliveryLoop() {
+            typedef std::chrono::steady_clock Clock;
+
+            // Deadlines are counted in samples from an epoch and converted to time only when waiting, so frames that are not a
+            // whole number of microseconds long, such as 512 samples at 44.1 kHz, do not drift. Until the first frame is
+            // delivered the period is unDefaultFrameMs, counted at a rate of 1000 per second.
+            Clock::time_point epoch = Clock::now();
+            unsigned int unRate = 1000;
+            unsigned int unPeriodSamples = m_sConfig.unDefaultFrameMs;
+            uint64_t ullSamples = 0;
+            bool bPrefilling = true;
+
+#if defined(_WIN32)
+            timeBeginPeriod(1);
+#endif
+
+            while (m_bStop.load(std::memory_order_relaxed) == false) {
+                std::this_thread::sleep_until(epoch + DurationOf(ullSamples, unRate));
+
+                if (Clock::now() > epoch + DurationOf(ullSamples + 2 * (uint64_t)unPeriodSamples, unRate)) {
+                    // Woken up far too late, for example after the process was suspended. Restart the cadence instead of bursting.
+                    epoch = Clock::now();
+                    ullSamples = 0;
+                }
+
+                uint64_t ullDeadline = ullSamples;
+                ullSamples += unPeriodSamples;
+
+                uint64_t ullRead = m_ullRead.load(std::memory_order_relaxed);
+                uint64_t ullFill = m_ullWrite.load(std::memory_order_acquire) - ullRead;
+
+                if (bPrefilling) {
+                    if (ullFill < m_sConfig.unPrefillFrames || ullFill == 0) {
+                        continue;
+                    }
+                    bPrefilling = false;
+                }
+
+                if (ullFill > m_sConfig.unDepth && m_sConfig.eOverflowPolicy == PLNK_BUFFERED_MIC_OVERFLOW_DROP_OLDEST) {
+                    uint64_t ullDrop = ullFill - m_sConfig.unDepth;
+                    ullRead += ullDrop;
+                    ullFill -= ullDrop;
+                    m_ullRead.store(ullRead, std::memory_order_release);
+                    m_ullOverflowFrames.fetch_add(ullDrop, std::memory_order_relaxed);
+                }
+
+                if (ullFill == 0) {
+                    m_ullUnderflows.fetch_add(1, std::memory_order_relaxed);
+                    bPrefilling = m_sConfig.unPrefillFrames > 0;
+
+                    if (m_sConfig.eUnderflowPolicy == PLNK_BUFFERED_MIC_UNDERFLOW_SILENCE && m_sSilence.unAudioDataSampleCount > 0) {
+                        PutAudioData(m_sSilence);
+                    }
+                    continue;
+                }
+
+                SAudioData& slot = m_pSlots[ullRead % m_unSlotCount];
+                if (slot.unAudioDataSamplingRate != 0 && slot.unAudioDataSampleCount != 0) {
+                    if (slot.unAudioDataSamplingRate != unRate) {
+                        // Move the epoch to this deadline, so the new rate counts from there.
+                        epoch += DurationOf(ullDeadline, unRate);
+                        ullDeadline = 0;
+                        unRate = slot.unAudioDataSamplingRate;
+                    }
+                    unPeriodSamples = slot.unAudioDataSampleCount;
+                    ullSamples = ullDeadline + unPeriodSamples;
+                }
+                RememberFormat(slot);
+
+                PutAudioData(slot);
+
+                // Hands the slot back to the producer only after the session is done with it.
+                m_ullRead.store(ullRead + 1, std::memory_order_release);
+                m_ullDeliveredFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+
+#if defined(_WIN32)
+            timeEndPeriod(1);
+#endif
+        }
+
+        static std::chrono::steady_clock::duration DurationOf(uint64_t ullSamples, unsigned int unRate) {
+            // Whole seconds and the remainder are converted separately, so the product cannot overflow in long sessions.
+            uint64_t ullNanoseconds = ullSamples / unRate * 1000000000ULL + ullSamples % unRate * 1000000000ULL / unRate;
+            return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(ullNanoseconds));
+        }
+
+        void RememberFormat(const SAudioData& audioData) {
+            m_sSilence.unAudioDataSamplingRate = audioData.unAudioDataSamplingRate;
+            m_sSilence.unAudioDataSampleCount = audioData.unAudioDataSampleCount;
+            m_sSilence.eAudioDataSampleFormat = audioData.eAudioDataSampleFormat;
+            m_sSilence.unBufferSize = audioData.unBufferSize;
+        }
+
+        SBufferedMicConfig m_sConfig;
+        unsigned int m_unSlotCount = 0;
+        SAudioData* m_pSlots = nullptr;
+        unsigned char* m_pSlotBuffer = nullptr;
+        SAudioData m_sSilence;
+
+        std::atomic<uint64_t> m_ullWrite{ 0 };
+        std::atomic<uint64_t> m_ullRead{ 0 };
+
+        std::atomic<uint64_t> m_ullEnqueuedFrames{ 0 };
+        std::atomic<uint64_t> m_ullDeliveredFrames{ 0 };
+        std::atomic<uint64_t> m_ullOverflowFrames{ 0 };
+        std::atomic<uint64_t> m_ullRejectedFrames{ 0 };
+        std::atomic<uint64_t> m_ullUnderflows{ 0 };
+
+        std::atomic<bool> m_bStop{ false };
+        std::thread m_thread;
+    };
+}
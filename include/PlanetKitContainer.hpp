@@ -16,10 +16,125 @@
 
 #include "PlanetKitPredefine.h"
 #include "PlanetKitMemory.h"
+#include <string.h>
+#include <new>
+#include <utility>
+#include <type_traits>
 
 namespace PlanetKit {
+    /**
+     * Non-owning view of contiguous elements.
+     * @remark
+     *   An ArrayView is only a pointer and a length. Copying or slicing it never copies elements or touches reference counts,
+     *   so it can be passed down by value. It does not keep the underlying memory alive, and becomes invalid when the
+     *   viewed Array is resized, cleared or destroyed.<br>
+     *   Use ArrayView<const T> for read-only access.
+     */
+    template <class T>
+    class ArrayView {
+    public:
+        ArrayView() : m_pData(nullptr), m_nSize(0) {
+        }
+
+        /**
+         * @param pData First element
+         * @param size Number of elements
+         */
+        ArrayView(T* pData, size_t size) : m_pData(pData), m_nSize(size) {
+        }
+
+        /**
+         * Converts a view of U, typically ArrayView<T> to ArrayView<const T>.
+         */
+        template <class U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+        ArrayView(const ArrayView<U>& src) : m_pData(src.Data()), m_nSize(src.Size()) {
+        }
+
+        /**
+         * Gets the first element.
+         */
+        T* Data() const {
+            return m_pData;
+        }
+
+        /**
+         * Gets the number of elements.
+         */
+        size_t Size() const {
+            return m_nSize;
+        }
+
+        /**
+         * Checks whether the view has no elements.
+         */
+        bool Empty() const {
+            return m_nSize == 0;
+        }
+
+        /**
+         * Gets the element at idx.
+         * @param idx Index of the view
+         * @return Element item
+         */
+        T& At(size_t idx) const {
+            return m_pData[idx];
+        }
+
+        /**
+         * Gets the element at idx.
+         * @param idx Index of the view
+         * @return Element item
+         */
+        T& operator[](size_t idx) const {
+            return m_pData[idx];
+        }
+
+        T* begin() const {
+            return m_pData;
+        }
+
+        T* end() const {
+            return m_pData + m_nSize;
+        }
+
+        /**
+         * Gets a view of count elements starting at offset.
+         * @param offset Index of the first element
+         * @param count Number of elements. The view is cut short at the end of this view.
+         * @remark Both values are clamped, so an out of range offset yields an empty view.
+         */
+        ArrayView<T> Slice(size_t offset, size_t count) const {
+            if (offset > m_nSize) {
+                offset = m_nSize;
+            }
+            if (count > m_nSize - offset) {
+                count = m_nSize - offset;
+            }
+            return ArrayView<T>(m_pData + offset, count);
+        }
+
+        /**
+         * Gets a view of the elements from offset to the end.
+         * @param offset Index of the first element
+         */
+        ArrayView<T> Slice(size_t offset) const {
+            return Slice(offset, m_nSize);
+        }
+
+    private:
+        T* m_pData;
+        size_t m_nSize;
+    };
+
+    template <class T>
+    class ArrayBuilder;
+
     /**
      * Array class.
+     * @remark
+     *   The SDK binary creates and fills arrays with its own copy of this class, so the layout stays {m_pData, m_nSize} and
+     *   the buffer always holds exactly Size() elements as far as the array knows. Growing reallocates every time; build
+     *   long arrays with ArrayBuilder.
      */
     template <class T>
     class PLANETKIT_API Array {
@@ -45,18 +160,27 @@ namespace PlanetKit {
             ASSERT(FALSE);
         }
 #endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+        /**
+         * Takes over the buffer of src. src becomes empty.
+         */
+        Array(Array<T>&& src) : m_pData(src.m_pData), m_nSize(src.m_nSize) {
+            src.m_pData = nullptr;
+            src.m_nSize = 0;
+        }
+#endif
+
         virtual ~Array() {
             Clear();
         }
 
         /**
-         * Clears all elements in the array.
+         * Clears all elements in the array and releases its memory.
          */
         void Clear() {
             if (m_pData) {
-                for (size_t i = 0; i < m_nSize; ++i) {
-                    m_pData[i].~T();
-                }
+                DestroyRange(0, m_nSize);
 
                 PlanetKitMemory::FreeArrayMemory(m_pData);
                 m_pData = nullptr;
@@ -80,23 +204,99 @@ namespace PlanetKit {
         }
 
         /**
-         * Sets the number of array elements and allocates memory.
+         * Sets the number of array elements.
          * @param size Size of the array
-         * @remark This API internally calls Clear() before resizing.
+         * @return false if the memory could not be allocated. The array is unchanged then.
+         * @remark
+         *   Existing elements up to size are kept, new elements are default-constructed and elements beyond size are destroyed.<br>
+         *   Growing reallocates to exactly size elements. Shrinking keeps the buffer.
          */
-        void Resize(size_t size) {
-            Clear();
+        bool Resize(size_t size) {
+            if (size < m_nSize) {
+                DestroyRange(size, m_nSize);
+            }
+            else if (size > m_nSize) {
+                if (Grow(size) == false) {
+                    return false;
+                }
+                ConstructRange(m_nSize, size, std::is_trivially_default_constructible<T>());
+            }
 
-            if (size > 0) {
-                T* pBuffer = static_cast<T*>(PlanetKitMemory::AllocateArrayMemory(size * sizeof(T)));
-                m_nSize = size;
+            m_nSize = size;
+            return true;
+        }
+
+        /**
+         * Sets the number of array elements without initializing new elements.
+         * @param size Size of the array
+         * @return false if the memory could not be allocated. The array is unchanged then.
+         * @remark
+         *   Only available for trivially copyable element types such as ByteArray.<br>
+         *   New elements have indeterminate values and must be written before being read.
+         */
+        template <typename U = T>
+        bool ResizeUninitialized(size_t size) {
+            // A member template, so explicit instantiations of Array for other element types do not trip the assertion.
+            static_assert(std::is_trivially_copyable<U>::value, "ResizeUninitialized requires a trivially copyable type");
 
-                for (size_t i = 0; i < m_nSize; ++i) {
-                    new (&pBuffer[i]) T();
+            if (size > m_nSize && Grow(size) == false) {
+                return false;
+            }
+
+            m_nSize = size;
+            return true;
+        }
+
+        /**
+         * Replaces the contents of the array with count elements copied from pSrc.
+         * @param pSrc Elements to be copied
+         * @param count Number of elements
+         * @return false if the memory could not be allocated. The array is unchanged then.
+         * @remark
+         *   For trivially copyable element types this is a single memcpy. The buffer is reused if count is not more than Size().<br>
+         *   pSrc must not point into this array.
+         */
+        bool Assign(const T* pSrc, size_t count) {
+            if (count > m_nSize) {
+                T* pBuffer = AllocateBuffer(count);
+                if (pBuffer == nullptr) {
+                    return false;
                 }
 
+                Clear();
                 m_pData = pBuffer;
             }
+            else {
+                DestroyRange(0, m_nSize);
+            }
+
+            m_nSize = 0;
+            CopyConstruct(m_pData, pSrc, count, std::is_trivially_copyable<T>());
+            m_nSize = count;
+            return true;
+        }
+
+        /**
+         * Removes the last element of the array.
+         * @remark The array must not be empty.
+         */
+        void PopBack() {
+            m_pData[m_nSize - 1].~T();
+            --m_nSize;
+        }
+
+        /**
+         * Removes the element at idx. Following elements are moved one position forward.
+         * @param idx Element index
+         */
+        void Erase(size_t idx) {
+            if (idx >= m_nSize) {
+                return;
+            }
+
+            ShiftDown(idx, std::is_trivially_copyable<T>());
+
+            PopBack();
         }
 
         /**
@@ -133,9 +333,148 @@ namespace PlanetKit {
             return m_pData[idx];
         }
 
+        T* begin() {
+            return m_pData;
+        }
+
+        T* end() {
+            return m_pData + m_nSize;
+        }
+
+        const T* begin() const {
+            return m_pData;
+        }
+
+        const T* end() const {
+            return m_pData + m_nSize;
+        }
+
+        /**
+         * Gets a view of all elements without copying them.
+         * @remark The view is invalidated by any call that changes the size of the array.
+         */
+        ArrayView<T> View() {
+            return ArrayView<T>(m_pData, m_nSize);
+        }
+
+        /**
+         * Gets a read-only view of all elements without copying them.
+         * @remark The view is invalidated by any call that changes the size of the array.
+         */
+        ArrayView<const T> View() const {
+            return ArrayView<const T>(m_pData, m_nSize);
+        }
+
+        /**
+         * Gets a read-only view of count elements starting at offset without copying them.
+         * @see ArrayView::Slice
+         */
+        ArrayView<const T> Slice(size_t offset, size_t count) const {
+            return View().Slice(offset, count);
+        }
+
         Array<T>& operator=(const Array<T>& src) = delete;
 
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+        /**
+         * Takes over the buffer of src. src becomes empty.
+         */
+        Array<T>& operator=(Array<T>&& src) {
+            if (this != &src) {
+                Clear();
+
+                m_pData = src.m_pData;
+                m_nSize = src.m_nSize;
+
+                src.m_pData = nullptr;
+                src.m_nSize = 0;
+            }
+
+            return *this;
+        }
+#endif
+
     private:
+        void DestroyRange(size_t first, size_t last) {
+            if (std::is_trivially_destructible<T>::value == false) {
+                for (size_t i = first; i < last; ++i) {
+                    m_pData[i].~T();
+                }
+            }
+        }
+
+        void ConstructRange(size_t first, size_t last, std::true_type) {
+            memset(static_cast<void*>(&m_pData[first]), 0, (last - first) * sizeof(T));
+        }
+
+        void ConstructRange(size_t first, size_t last, std::false_type) {
+            for (size_t i = first; i < last; ++i) {
+                new (&m_pData[i]) T();
+            }
+        }
+
+        static void CopyConstruct(T* pDst, const T* pSrc, size_t count, std::true_type) {
+            if (count > 0) {
+                memcpy(static_cast<void*>(pDst), static_cast<const void*>(pSrc), count * sizeof(T));
+            }
+        }
+
+        static void CopyConstruct(T* pDst, const T* pSrc, size_t count, std::false_type) {
+            for (size_t i = 0; i < count; ++i) {
+                new (&pDst[i]) T(pSrc[i]);
+            }
+        }
+
+        static void Relocate(T* pDst, T* pSrc, size_t count, std::true_type) {
+            CopyConstruct(pDst, pSrc, count, std::true_type());
+        }
+
+        static void Relocate(T* pDst, T* pSrc, size_t count, std::false_type) {
+            for (size_t i = 0; i < count; ++i) {
+                new (&pDst[i]) T(std::move(pSrc[i]));
+                pSrc[i].~T();
+            }
+        }
+
+        void ShiftDown(size_t idx, std::true_type) {
+            memmove(static_cast<void*>(&m_pData[idx]), static_cast<const void*>(&m_pData[idx + 1]), (m_nSize - idx - 1) * sizeof(T));
+        }
+
+        void ShiftDown(size_t idx, std::false_type) {
+            for (size_t i = idx + 1; i < m_nSize; ++i) {
+                m_pData[i - 1] = std::move(m_pData[i]);
+            }
+        }
+
+        static T* AllocateBuffer(size_t capacity) {
+            if (capacity > SIZE_MAX / sizeof(T)) {
+                return nullptr;
+            }
+            return static_cast<T*>(PlanetKitMemory::AllocateArrayMemory(capacity * sizeof(T)));
+        }
+
+        /**
+         * Moves the elements into pBuffer and releases the current buffer.
+         */
+        void Adopt(T* pBuffer) {
+            Relocate(pBuffer, m_pData, m_nSize, std::is_trivially_copyable<T>());
+
+            if (m_pData) {
+                PlanetKitMemory::FreeArrayMemory(m_pData);
+            }
+
+            m_pData = pBuffer;
+        }
+
+        bool Grow(size_t capacity) {
+            T* pBuffer = AllocateBuffer(capacity);
+            if (pBuffer == nullptr) {
+                return false;
+            }
+
+            Adopt(pBuffer);
+            return true;
+        }
 
 #if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
         T* m_pData = nullptr;
@@ -148,5 +487,11 @@ namespace PlanetKit {
 #else
         size_t m_nSize;
 #endif
+
+        // Grows the buffer geometrically and keeps track of its capacity itself.
+        friend class ArrayBuilder<T>;
     };
+
+    // Arrays are exchanged with the SDK binary, for example as PeerArray in conference events, so the layout must stay the same.
+    static_assert(sizeof(Array<unsigned char>) == sizeof(void*) + sizeof(unsigned char*) + sizeof(size_t), "Array must keep the layout of the SDK binary");
 };
\ No newline at end of file
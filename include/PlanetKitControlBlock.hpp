@@ -16,8 +16,92 @@
 
 #include "PlanetKitPredefine.h"
 #include "PlanetKitMemory.h"
+#include <atomic>
+#include <utility>
 
 namespace PlanetKit {
+    /**
+     * Thread-safe reference count policy. This is the default for InplaceSharedPtr.
+     * @remark
+     *   Increments are relaxed because taking another reference only needs an existing one.
+     *   Decrements are acquire-release so that the thread dropping the last reference sees every write made through the others.
+     */
+    struct AtomicRefCountPolicy {
+        typedef std::atomic<long> Counter;
+
+        static void Increment(Counter& count) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void Add(Counter& count, long value) {
+            count.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        /**
+         * @return The count after the decrement.
+         */
+        static long Decrement(Counter& count) {
+            return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+
+        /**
+         * Increments the count unless it is already zero.
+         */
+        static bool IncrementIfNonZero(Counter& count) {
+            long value = count.load(std::memory_order_relaxed);
+            while (value != 0) {
+                if (count.compare_exchange_weak(value, value + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static long Load(const Counter& count) {
+            return count.load(std::memory_order_acquire);
+        }
+    };
+
+    /**
+     * Plain reference count policy for objects that never leave the thread that created them.
+     * @remark
+     *   Avoids atomic instructions entirely. Copying, releasing or locking such a LocalSharedPtr or WeakPtr from more than
+     *   one thread is a data race. Use MakeLocalAutoPtr to create one.
+     */
+    struct SingleThreadRefCountPolicy {
+        typedef long Counter;
+
+        static void Increment(Counter& count) {
+            ++count;
+        }
+
+        static void Add(Counter& count, long value) {
+            count += value;
+        }
+
+        static long Decrement(Counter& count) {
+            return --count;
+        }
+
+        static bool IncrementIfNonZero(Counter& count) {
+            if (count == 0) {
+                return false;
+            }
+            ++count;
+            return true;
+        }
+
+        static long Load(const Counter& count) {
+            return count;
+        }
+    };
+
+    /**
+     * Control block of SharedPtr.
+     * @remark
+     *   The SDK binary creates and releases these blocks too, so the layout {vptr, ptr_, ref_count_} and the release path
+     *   must stay as they are. std::atomic<LONG> has the size of LONG and updates the count with the same locked instructions.
+     */
     template <typename T>
     class PLANETKIT_API ControlBlock {
     public:
@@ -26,11 +110,15 @@ namespace PlanetKit {
         virtual ~ControlBlock() {}
 
         void addRef() {
-            InterlockedIncrement(&ref_count_);
+            ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void addRef(LONG count) {
+            ref_count_.fetch_add(count, std::memory_order_relaxed);
         }
 
         void release() {
-            if (InterlockedDecrement(&ref_count_) == 0) {
+            if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
                 ptr_->~T();
                 PlanetKitMemory::FreeMemory(ptr_);
                 ptr_ = nullptr;
@@ -46,6 +134,93 @@ namespace PlanetKit {
 
     private:
         T* ptr_;
-        LONG ref_count_;
+        std::atomic<LONG> ref_count_;
+
+        static_assert(sizeof(std::atomic<LONG>) == sizeof(LONG) && alignof(std::atomic<LONG>) == alignof(LONG), "ControlBlock must keep the layout of the SDK binary");
+    };
+
+    /**
+     * Control block of InplaceSharedPtr. The managed object lives inside the block.
+     * @remark
+     *   Only the header templates create and destroy these blocks. They are never handed to the SDK, which only knows ControlBlock.<br>
+     *   Besides the strong count the block keeps a weak count for WeakPtr. All strong references together hold one weak reference.
+     */
+    template <typename RefCountPolicy = AtomicRefCountPolicy>
+    class InplaceControlBlockBase {
+    public:
+        InplaceControlBlockBase() : ref_count_(1), weak_count_(1) {}
+
+        void addRef() {
+            RefCountPolicy::Increment(ref_count_);
+        }
+
+        /**
+         * Adds a strong reference only if the object is still alive.
+         * @return false if the last strong reference has already been released.
+         */
+        bool addRefIfAlive() {
+            return RefCountPolicy::IncrementIfNonZero(ref_count_);
+        }
+
+        bool isAlive() const {
+            return RefCountPolicy::Load(ref_count_) != 0;
+        }
+
+        void release() {
+            if (RefCountPolicy::Decrement(ref_count_) == 0) {
+                dispose();
+                releaseWeakRef();
+            }
+        }
+
+        void addWeakRef() {
+            RefCountPolicy::Increment(weak_count_);
+        }
+
+        /**
+         * Releases a weak reference. The block is freed once no strong or weak reference is left.
+         */
+        void releaseWeakRef() {
+            if (RefCountPolicy::Decrement(weak_count_) == 0) {
+                this->~InplaceControlBlockBase();
+                PlanetKitMemory::FreeMemory(this);
+            }
+        }
+
+    protected:
+        virtual ~InplaceControlBlockBase() {}
+
+        /**
+         * Destroys the managed object when the last reference is released.
+         */
+        virtual void dispose() = 0;
+
+    private:
+        typename RefCountPolicy::Counter ref_count_;
+        typename RefCountPolicy::Counter weak_count_;
+    };
+
+    /**
+     * Control block that stores T inline, right after the reference count, so that the block and the object share a single allocation.
+     */
+    template <typename T, typename RefCountPolicy = AtomicRefCountPolicy>
+    class InplaceControlBlock : public InplaceControlBlockBase<RefCountPolicy> {
+    public:
+        template <typename... Args>
+        explicit InplaceControlBlock(Args&&... args) {
+            new (&storage_) T(std::forward<Args>(args)...);
+        }
+
+        T* getPtr() {
+            return reinterpret_cast<T*>(&storage_);
+        }
+
+    protected:
+        void dispose() override {
+            getPtr()->~T();
+        }
+
+    private:
+        alignas(T) unsigned char storage_[sizeof(T)];
     };
-};
\ No newline at end of file
+};
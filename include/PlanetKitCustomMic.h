@@ -15,6 +15,7 @@
 #pragma once
 
 #include "PlanetKitMic.h"
+#include "PlanetKitAtomicSharedPtr.hpp"
 
 namespace PlanetKit {
     class CustomMic;
@@ -44,13 +45,16 @@ namespace PlanetKit {
          * @remark To implement custom microphone and put audio data to a call or conference session, you need to call the respective function.
          */
         bool PutAudioData(SAudioData& audioData) {
-            if (m_pMicEvent.hasValue() == false) {
+            // Loaded into a local so that the event stays alive even if it is deregistered during the call.
+            MicEventPtr pEvent = m_pMicEvent.load();
+            if (pEvent.hasValue() == false) {
                 return false;
             }
 
-            return m_pMicEvent->DidCapture(audioData);
+            return pEvent->DidCapture(audioData);
         }
     protected:
-        MicEventPtr m_pMicEvent;
+        /// Read by the audio thread while another thread may register or deregister the event.
+        AtomicSharedPtr<IMicEvent> m_pMicEvent;
     };
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "PlanetkitSpeaker.h"
+#include "PlanetKitAtomicSharedPtr.hpp"
 
 namespace PlanetKit {
     class CustomSpeaker;
@@ -44,14 +45,17 @@ namespace PlanetKit {
          * @remark To implement custom audio and pull audio data from a call or conference session, you need to call the respective function.
          */
         virtual bool PullAudioData(SAudioData& audioData) {
-            if (m_pSpeakerEvent.hasValue() == false) {
+            // Loaded into a local so that the event stays alive even if it is deregistered during the call.
+            SpeakerEventPtr pEvent = m_pSpeakerEvent.load();
+            if (pEvent.hasValue() == false) {
                 return false;
             }
 
-            return m_pSpeakerEvent->WillPlay(audioData);
+            return pEvent->WillPlay(audioData);
         }
 
     protected:
-        SpeakerEventPtr m_pSpeakerEvent;
+        /// Read by the audio thread while another thread may register or deregister the event.
+        AtomicSharedPtr<ISpeakerEvent> m_pSpeakerEvent;
     };
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "PlanetKitString.hpp"
+
+namespace PlanetKit {
+    /**
+     * Computes the 64-bit FNV-1a hash of nLen characters.
+     */
+    template <typename CharT>
+    inline uint64_t HashChars(const CharT* pData, size_t nLen, uint64_t ullSeed = 14695981039346656037ULL) {
+        uint64_t ullHash = ullSeed;
+        for (size_t i = 0; i < nLen; ++i) {
+            ullHash ^= (uint64_t)(typename std::make_unsigned<CharT>::type)pData[i];
+            ullHash *= 1099511628211ULL;
+        }
+        return ullHash;
+    }
+
+    /**
+     * Scrambles the bits of a 64-bit value (splitmix64 finalizer).
+     */
+    inline uint64_t HashMix(uint64_t ullValue) {
+        ullValue ^= ullValue >> 30;
+        ullValue *= 0xBF58476D1CE4E5B9ULL;
+        ullValue ^= ullValue >> 27;
+        ullValue *= 0x94D049BB133111EBULL;
+        ullValue ^= ullValue >> 31;
+        return ullValue;
+    }
+
+    /**
+     * Hashing and equality used by HashMap.
+     * @remark
+     *   The primary template uses T::GetHash() and operator==, which covers types such as SubgroupAtom.<br>
+     *   Specialize it for other key types.
+     */
+    template <typename T, typename Enable = void>
+    struct HashTraits {
+        static uint64_t Hash(const T& value) {
+            return value.GetHash();
+        }
+
+        static bool Equal(const T& lhs, const T& rhs) {
+            return lhs == rhs;
+        }
+    };
+
+    template <typename T>
+    struct HashTraits<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+        static uint64_t Hash(const T& value) {
+            return HashMix((uint64_t)value);
+        }
+
+        static bool Equal(const T& lhs, const T& rhs) {
+            return lhs == rhs;
+        }
+    };
+
+    template <typename T>
+    struct HashTraits<T*, void> {
+        static uint64_t Hash(T* value) {
+            return HashMix((uint64_t)(uintptr_t)value);
+        }
+
+        static bool Equal(T* lhs, T* rhs) {
+            return lhs == rhs;
+        }
+    };
+
+    template <>
+    struct HashTraits<WString, void> {
+        static uint64_t Hash(const WString& value) {
+            return HashChars(value.c_str(), value.Size());
+        }
+
+        static bool Equal(const WString& lhs, const WString& rhs) {
+            return lhs == rhs;
+        }
+    };
+
+    template <>
+    struct HashTraits<String, void> {
+        static uint64_t Hash(const String& value) {
+            return HashChars(value.c_str(), value.Size());
+        }
+
+        static bool Equal(const String& lhs, const String& rhs) {
+            return lhs == rhs;
+        }
+    };
+};
@@ -0,0 +1,417 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+#include "PlanetKitPredefine.h"
+#include "PlanetKitMemory.h"
+#include "PlanetKitHash.hpp"
+
+namespace PlanetKit {
+    /**
+     * Open-addressing hash map.
+     * @remark
+     *   Entries are stored in a single PlanetKitMemory array with linear probing, and the full 64-bit hash of each key
+     *   is kept next to it so that a lookup rarely compares keys that do not match and stored keys are never hashed again.<br>
+     *   Erase shifts following entries back instead of leaving tombstones, so lookups stay short after heavy churn.<br>
+     *   Pointers returned by Find() and Insert() are invalidated by the next insertion of a new key or by an erase.
+     */
+    template <typename K, typename V, typename Traits = HashTraits<K>>
+    class PLANETKIT_API HashMap {
+    private:
+        struct Entry {
+            K key;
+            V value;
+        };
+
+    public:
+        /**
+         * Entry seen through an iterator. The key cannot be changed, and the value only through a non-const map.
+         */
+        template <typename ValueT>
+        struct EntryReference {
+            const K& key;
+            ValueT& value;
+
+            const EntryReference* operator->() const {
+                return this;
+            }
+        };
+
+        /**
+         * Iterates over the entries in unspecified order.
+         * @remark Dereferencing yields an EntryReference by value, so write for (auto entry : map) or for (const auto& entry : map).
+         */
+        template <typename ValueT>
+        class IteratorT {
+        public:
+            IteratorT(const HashMap* pMap, size_t nIndex) : m_pMap(pMap), m_nIndex(nIndex) {
+                Skip();
+            }
+
+            EntryReference<ValueT> operator*() const {
+                Entry& entry = m_pMap->m_pEntries[m_nIndex];
+                return EntryReference<ValueT>{ entry.key, entry.value };
+            }
+
+            EntryReference<ValueT> operator->() const {
+                return **this;
+            }
+
+            IteratorT& operator++() {
+                ++m_nIndex;
+                Skip();
+                return *this;
+            }
+
+            bool operator==(const IteratorT& rhs) const {
+                return m_nIndex == rhs.m_nIndex;
+            }
+
+            bool operator!=(const IteratorT& rhs) const {
+                return m_nIndex != rhs.m_nIndex;
+            }
+
+        private:
+            void Skip() {
+                while (m_nIndex < m_pMap->m_nCapacity && m_pMap->m_pHashes[m_nIndex] == 0) {
+                    ++m_nIndex;
+                }
+            }
+
+            const HashMap* m_pMap;
+            size_t m_nIndex;
+        };
+
+        typedef IteratorT<V> Iterator;
+        typedef IteratorT<const V> ConstIterator;
+
+        HashMap() = default;
+
+        /**
+         * Do not support copy constructor.
+         */
+        HashMap(const HashMap& src) = delete;
+        HashMap& operator=(const HashMap& src) = delete;
+
+        HashMap(HashMap&& src) :
+            m_pHashes(src.m_pHashes),
+            m_pEntries(src.m_pEntries),
+            m_nCapacity(src.m_nCapacity),
+            m_nSize(src.m_nSize)
+        {
+            src.m_pHashes = nullptr;
+            src.m_pEntries = nullptr;
+            src.m_nCapacity = 0;
+            src.m_nSize = 0;
+        }
+
+        HashMap& operator=(HashMap&& src) {
+            if (this != &src) {
+                Clear();
+
+                m_pHashes = src.m_pHashes;
+                m_pEntries = src.m_pEntries;
+                m_nCapacity = src.m_nCapacity;
+                m_nSize = src.m_nSize;
+
+                src.m_pHashes = nullptr;
+                src.m_pEntries = nullptr;
+                src.m_nCapacity = 0;
+                src.m_nSize = 0;
+            }
+            return *this;
+        }
+
+        virtual ~HashMap() {
+            Clear();
+        }
+
+        /**
+         * Gets the number of entries.
+         */
+        size_t Size() const {
+            return m_nSize;
+        }
+
+        /**
+         * Removes all entries and releases the memory.
+         */
+        void Clear() {
+            if (m_pHashes) {
+                for (size_t i = 0; i < m_nCapacity; ++i) {
+                    if (m_pHashes[i] != 0) {
+                        m_pEntries[i].~Entry();
+                    }
+                }
+
+                PlanetKitMemory::FreeArrayMemory(m_pHashes);
+                PlanetKitMemory::FreeArrayMemory(m_pEntries);
+                m_pHashes = nullptr;
+                m_pEntries = nullptr;
+            }
+
+            m_nCapacity = 0;
+            m_nSize = 0;
+        }
+
+        /**
+         * Allocates room for at least nCount entries without rehashing.
+         * @return false if the memory could not be allocated, or nCount is too large to be represented.
+         */
+        bool Reserve(size_t nCount) {
+            size_t nCapacity = 8;
+            while (nCapacity - nCapacity / 4 < nCount) {
+                if (nCapacity > SIZE_MAX / 2) {
+                    return false;
+                }
+                nCapacity *= 2;
+            }
+
+            if (nCapacity > m_nCapacity) {
+                return Rehash(nCapacity);
+            }
+            return true;
+        }
+
+        /**
+         * Finds the value of key.
+         * @return Pointer to the value, or nullptr if key is not in the map.
+         */
+        V* Find(const K& key) {
+            size_t nIndex = 0;
+            return FindIndex(key, HashOf(key), nIndex) ? &m_pEntries[nIndex].value : nullptr;
+        }
+
+        const V* Find(const K& key) const {
+            size_t nIndex = 0;
+            return FindIndex(key, HashOf(key), nIndex) ? &m_pEntries[nIndex].value : nullptr;
+        }
+
+        /**
+         * Checks whether key is in the map.
+         */
+        bool Contains(const K& key) const {
+            return Find(key) != nullptr;
+        }
+
+        /**
+         * Inserts key with value, or replaces the value if key is already in the map.
+         * @return Pointer to the stored value, or nullptr if the memory could not be allocated.
+         * @remark key and value may refer to entries of this map.
+         */
+        template <typename U>
+        V* Insert(const K& key, U&& value) {
+            uint64_t ullHash = HashOf(key);
+            size_t nIndex = 0;
+            if (FindIndex(key, ullHash, nIndex)) {
+                m_pEntries[nIndex].value = std::forward<U>(value);
+                return &m_pEntries[nIndex].value;
+            }
+
+            if (IsFull()) {
+                // key and value may live in the current storage, which growing releases.
+                Entry entry{ key, V(std::forward<U>(value)) };
+                if (Grow() == false) {
+                    return nullptr;
+                }
+                return Place(FindEmpty(ullHash), ullHash, std::move(entry.key), std::move(entry.value));
+            }
+
+            return Place(nIndex, ullHash, key, std::forward<U>(value));
+        }
+
+        /**
+         * Gets the value of key, inserting a value constructed from args if key is not in the map.
+         * @param args Arguments forwarded to the constructor of the value. Unused if key is already in the map.
+         * @return Pointer to the stored value, or nullptr if the memory could not be allocated.
+         * @remark Looking up a key that is already in the map never rehashes. key and args may refer to entries of this map.
+         */
+        template <typename... Args>
+        V* TryEmplace(const K& key, Args&&... args) {
+            uint64_t ullHash = HashOf(key);
+            size_t nIndex = 0;
+            if (FindIndex(key, ullHash, nIndex)) {
+                return &m_pEntries[nIndex].value;
+            }
+
+            if (IsFull()) {
+                Entry entry{ key, V(std::forward<Args>(args)...) };
+                if (Grow() == false) {
+                    return nullptr;
+                }
+                return Place(FindEmpty(ullHash), ullHash, std::move(entry.key), std::move(entry.value));
+            }
+
+            return Place(nIndex, ullHash, key, V(std::forward<Args>(args)...));
+        }
+
+        /**
+         * Removes key from the map.
+         * @return true if key was in the map.
+         */
+        bool Erase(const K& key) {
+            size_t i = 0;
+            if (FindIndex(key, HashOf(key), i) == false) {
+                return false;
+            }
+
+            size_t nMask = m_nCapacity - 1;
+            m_pEntries[i].~Entry();
+            m_pHashes[i] = 0;
+            --m_nSize;
+
+            // Shift back following entries of the same probe run so that no lookup stops at the new hole too early.
+            size_t nHole = i;
+            for (size_t j = (i + 1) & nMask; m_pHashes[j] != 0; j = (j + 1) & nMask) {
+                size_t nHome = (size_t)m_pHashes[j] & nMask;
+                if (((j - nHome) & nMask) >= ((j - nHole) & nMask)) {
+                    new (&m_pEntries[nHole]) Entry(std::move(m_pEntries[j]));
+                    m_pEntries[j].~Entry();
+                    m_pHashes[nHole] = m_pHashes[j];
+                    m_pHashes[j] = 0;
+                    nHole = j;
+                }
+            }
+
+            return true;
+        }
+
+        Iterator begin() {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() {
+            return Iterator(this, m_nCapacity);
+        }
+
+        ConstIterator begin() const {
+            return ConstIterator(this, 0);
+        }
+
+        ConstIterator end() const {
+            return ConstIterator(this, m_nCapacity);
+        }
+
+    private:
+        static uint64_t HashOf(const K& key) {
+            // 0 marks an empty slot.
+            uint64_t ullHash = Traits::Hash(key);
+            return ullHash == 0 ? 1 : ullHash;
+        }
+
+        /**
+         * Probes for key.
+         * @param nIndex Set to the slot of key if found, otherwise to the empty slot that ended the probe.
+         * @return true if key was found.
+         */
+        bool FindIndex(const K& key, uint64_t ullHash, size_t& nIndex) const {
+            if (m_nCapacity == 0) {
+                return false;
+            }
+
+            size_t nMask = m_nCapacity - 1;
+            size_t i = (size_t)ullHash & nMask;
+            for (; m_pHashes[i] != 0; i = (i + 1) & nMask) {
+                if (m_pHashes[i] == ullHash && Traits::Equal(m_pEntries[i].key, key)) {
+                    nIndex = i;
+                    return true;
+                }
+            }
+
+            nIndex = i;
+            return false;
+        }
+
+        size_t FindEmpty(uint64_t ullHash) const {
+            size_t nMask = m_nCapacity - 1;
+            size_t i = (size_t)ullHash & nMask;
+            while (m_pHashes[i] != 0) {
+                i = (i + 1) & nMask;
+            }
+            return i;
+        }
+
+        bool IsFull() const {
+            return (m_nSize + 1) > m_nCapacity - m_nCapacity / 4;
+        }
+
+        bool Grow() {
+            return Rehash(m_nCapacity == 0 ? 8 : m_nCapacity * 2);
+        }
+
+        template <typename KeyT, typename ValueT>
+        V* Place(size_t nIndex, uint64_t ullHash, KeyT&& key, ValueT&& value) {
+            new (&m_pEntries[nIndex]) Entry{ K(std::forward<KeyT>(key)), V(std::forward<ValueT>(value)) };
+            m_pHashes[nIndex] = ullHash;
+            ++m_nSize;
+            return &m_pEntries[nIndex].value;
+        }
+
+        bool Rehash(size_t nCapacity) {
+            if (nCapacity > SIZE_MAX / sizeof(Entry)) {
+                return false;
+            }
+
+            uint64_t* pHashes = static_cast<uint64_t*>(PlanetKitMemory::AllocateArrayMemory(nCapacity * sizeof(uint64_t)));
+            Entry* pEntries = static_cast<Entry*>(PlanetKitMemory::AllocateArrayMemory(nCapacity * sizeof(Entry)));
+            if (pHashes == nullptr || pEntries == nullptr) {
+                if (pHashes) {
+                    PlanetKitMemory::FreeArrayMemory(pHashes);
+                }
+                if (pEntries) {
+                    PlanetKitMemory::FreeArrayMemory(pEntries);
+                }
+                return false;
+            }
+
+            for (size_t i = 0; i < nCapacity; ++i) {
+                pHashes[i] = 0;
+            }
+
+            size_t nMask = nCapacity - 1;
+            for (size_t i = 0; i < m_nCapacity; ++i) {
+                if (m_pHashes[i] != 0) {
+                    size_t j = (size_t)m_pHashes[i] & nMask;
+                    while (pHashes[j] != 0) {
+                        j = (j + 1) & nMask;
+                    }
+
+                    new (&pEntries[j]) Entry(std::move(m_pEntries[i]));
+                    m_pEntries[i].~Entry();
+                    pHashes[j] = m_pHashes[i];
+                }
+            }
+
+            if (m_pHashes) {
+                PlanetKitMemory::FreeArrayMemory(m_pHashes);
+                PlanetKitMemory::FreeArrayMemory(m_pEntries);
+            }
+
+            m_pHashes = pHashes;
+            m_pEntries = pEntries;
+            m_nCapacity = nCapacity;
+            return true;
+        }
+
+        uint64_t* m_pHashes = nullptr;
+        Entry* m_pEntries = nullptr;
+        size_t m_nCapacity = 0;
+        size_t m_nSize = 0;
+    };
+};
@@ -24,5 +24,42 @@ namespace PlanetKit {
         static void* AllocateArrayMemory(size_t size);
         static void FreeArrayMemory(void* ptr);
 
+        /**
+         * Allocates memory aligned to alignment on top of AllocateMemory().
+         * @param size Size in bytes.
+         * @param alignment Alignment in bytes. Must be a power of two.
+         * @return Pointer to the allocated memory, or nullptr on failure.
+         * @remark Free the returned memory with FreeAlignedMemory().
+         */
+        static void* AllocateAlignedMemory(size_t size, size_t alignment) {
+            if (alignment < sizeof(void*)) {
+                alignment = sizeof(void*);
+            }
+
+            // The pointer returned by AllocateMemory() is stored in the slot right in front of the aligned pointer.
+            size_t nTotal = size + alignment - 1 + sizeof(void*);
+            if (nTotal < size) {
+                return nullptr;
+            }
+
+            unsigned char* pBase = static_cast<unsigned char*>(AllocateMemory(nTotal));
+            if (pBase == nullptr) {
+                return nullptr;
+            }
+
+            uintptr_t uStart = reinterpret_cast<uintptr_t>(pBase) + sizeof(void*);
+            unsigned char* pAligned = reinterpret_cast<unsigned char*>((uStart + alignment - 1) & ~(uintptr_t)(alignment - 1));
+            reinterpret_cast<void**>(pAligned)[-1] = pBase;
+            return pAligned;
+        }
+
+        /**
+         * Frees memory returned by AllocateAlignedMemory(). nullptr is ignored.
+         */
+        static void FreeAlignedMemory(void* ptr) {
+            if (ptr != nullptr) {
+                FreeMemory(static_cast<void**>(ptr)[-1]);
+            }
+        }
     };
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #pragma once
 
 #include "PlanetKitPredefine.h"
+#include <utility>
 
 namespace PlanetKit {
     struct PLANETKIT_API Nullopt {
@@ -29,14 +30,24 @@ namespace PlanetKit {
 
     /**
      * PlanetKit Optional class.
-     * @remark Use like std::optional in C++17
+     * @remark
+     *   Use like std::optional in C++17<br>
+     *   The SDK binary shares Optional objects with the application, so the layout stays {m_bHasValue, m_value}
+     *   and m_value is always constructed, even while the Optional is empty.
      */
     template <typename T>
     class PLANETKIT_API Optional {
     public:
-        Optional(const T& src) {
-            m_value = src;
-            m_bHasValue = true;
+        Optional(const T& src) : m_bHasValue(true), m_value(src) {
+        };
+
+        Optional(T&& src) : m_bHasValue(true), m_value(std::move(src)) {
+        };
+
+        Optional(const Optional<T>& src) : m_bHasValue(src.m_bHasValue), m_value(src.m_value) {
+        };
+
+        Optional(Optional<T>&& src) : m_bHasValue(src.m_bHasValue), m_value(std::move(src.m_value)) {
         };
 
         Optional(const Nullopt&) {
@@ -110,6 +121,25 @@ namespace PlanetKit {
             return *this;
         }
 
+        /**
+         * Move optional value if it has value.
+         */
+        Optional<T>& operator=(Optional<T>&& src) {
+            m_bHasValue = src.m_bHasValue;
+            if (m_bHasValue) {
+                m_value = std::move(src.m_value);
+            }
+            return *this;
+        }
+
+        /**
+         * Clears optional value.
+         */
+        Optional<T>& operator=(const Nullopt&) {
+            Reset();
+            return *this;
+        }
+
         /**
          * Sets optional value.
          */
@@ -120,6 +150,35 @@ namespace PlanetKit {
             return *this;
         }
 
+        /**
+         * Sets optional value by moving src.
+         */
+        Optional<T>& operator=(T&& src) {
+            m_bHasValue = true;
+            m_value = std::move(src);
+
+            return *this;
+        }
+
+        /**
+         * Sets optional value to a T constructed from args.
+         * @return The new value.
+         */
+        template <typename... Args>
+        T& Emplace(Args&&... args) {
+            m_value = T(std::forward<Args>(args)...);
+            m_bHasValue = true;
+            return m_value;
+        }
+
+        /**
+         * Clears optional value and releases what it holds.
+         */
+        void Reset() {
+            m_bHasValue = false;
+            m_value = T();
+        }
+
         /**
          * Gets optional value if it has value.
          * @remark
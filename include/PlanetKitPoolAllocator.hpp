@@ -0,0 +1,358 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "PlanetKitPredefine.h"
+
+/// Largest allocation served from the size-class pools. Larger requests go straight to the system heap.
+#define PLNK_POOL_MAX_BLOCK_SIZE                1024
+/// Size of a chunk that is carved into blocks of one size class. Chunks are aligned to their size.
+#define PLNK_POOL_CHUNK_SIZE                    (64 * 1024)
+
+namespace PlanetKit {
+    /**
+     * Size-class pool allocator with per-thread caches.
+     * @remark
+     *   The pool serves the application's own small, short-lived objects. It is independent of PlanetKitMemory, so memory
+     *   from it must never be handed to the SDK or freed anywhere else.<br>
+     *   Requests up to PLNK_POOL_MAX_BLOCK_SIZE bytes with an alignment of 16 or less are served from per-thread free lists
+     *   without locking. A block freed by another thread is pushed lock-free onto its owner's remote list and is picked up
+     *   when the owner runs out of blocks of that class.<br>
+     *   Free() takes the size and alignment given to Allocate(), so blocks carry no header. Blocks are packed back to back
+     *   and find their chunk by masking their address with the chunk size.<br>
+     *   Call Reclaim() on a thread, for example at the end of a session, to return its completely unused chunks to the system.
+     *   Destroying the pool releases every chunk at once, so it must outlive all memory allocated from it and every thread that used it.
+     */
+    class PlanetKitPoolAllocator {
+    public:
+        PlanetKitPoolAllocator() = default;
+
+        PlanetKitPoolAllocator(const PlanetKitPoolAllocator&) = delete;
+        PlanetKitPoolAllocator& operator=(const PlanetKitPoolAllocator&) = delete;
+
+        ~PlanetKitPoolAllocator() {
+            ThreadCache* pCache = m_pCaches;
+            while (pCache != nullptr) {
+                ThreadCache* pNext = pCache->pNextCache;
+
+                Chunk* pChunk = pCache->pChunks;
+                while (pChunk != nullptr) {
+                    Chunk* pNextChunk = pChunk->pNext;
+                    FreeSystemAligned(pChunk);
+                    pChunk = pNextChunk;
+                }
+
+                pCache->~ThreadCache();
+                FreeSystemAligned(pCache);
+                pCache = pNext;
+            }
+
+            if (GetSlot().pPool == this) {
+                GetSlot().pPool = nullptr;
+                GetSlot().pCache = nullptr;
+            }
+        }
+
+        /**
+         * Allocates memory.
+         * @param size Size in bytes.
+         * @param alignment Alignment in bytes. Must be a power of two.
+         * @return Pointer to the allocated memory, or nullptr on failure.
+         */
+        void* Allocate(size_t size, size_t alignment = BLOCK_ALIGNMENT) {
+            if (IsLarge(size, alignment)) {
+                return AllocateSystemAligned(size, alignment < BLOCK_ALIGNMENT ? (size_t)BLOCK_ALIGNMENT : alignment);
+            }
+
+            unsigned int unClass = ClassOf(size);
+            ThreadCache* pCache = GetCache();
+            if (pCache == nullptr) {
+                return nullptr;
+            }
+
+            Block* pBlock = pCache->pFreeLists[unClass];
+            if (pBlock == nullptr) {
+                DrainRemoteFrees(pCache);
+                pBlock = pCache->pFreeLists[unClass];
+
+                if (pBlock == nullptr) {
+                    if (AddChunk(pCache, unClass) == false) {
+                        return nullptr;
+                    }
+                    pBlock = pCache->pFreeLists[unClass];
+                }
+            }
+
+            pCache->pFreeLists[unClass] = pBlock->pNext;
+            ++ChunkOf(pBlock)->unLive;
+
+            return pBlock;
+        }
+
+        /**
+         * Frees memory returned by Allocate.
+         * @param ptr Pointer returned by Allocate. nullptr is ignored.
+         * @param size The size passed to Allocate.
+         * @param alignment The alignment passed to Allocate.
+         */
+        void Free(void* ptr, size_t size, size_t alignment = BLOCK_ALIGNMENT) {
+            if (ptr == nullptr) {
+                return;
+            }
+
+            if (IsLarge(size, alignment)) {
+                FreeSystemAligned(ptr);
+                return;
+            }
+
+            Chunk* pChunk = ChunkOf(ptr);
+            ThreadCache* pOwner = pChunk->pOwner;
+            Block* pBlock = static_cast<Block*>(ptr);
+
+            if (GetSlot().pPool == this && GetSlot().pCache == pOwner) {
+                pBlock->pNext = pOwner->pFreeLists[pChunk->unClass];
+                pOwner->pFreeLists[pChunk->unClass] = pBlock;
+                --pChunk->unLive;
+            }
+            else {
+                Block* pHead = pOwner->pRemoteFrees.load(std::memory_order_relaxed);
+                do {
+                    pBlock->pNext = pHead;
+                } while (pOwner->pRemoteFrees.compare_exchange_weak(pHead, pBlock, std::memory_order_release, std::memory_order_relaxed) == false);
+            }
+        }
+
+        /**
+         * Returns the chunks of the calling thread that have no live block to the system.
+         * @remark Call it on a thread that has finished its work, for example after a session ends.
+         */
+        void Reclaim() {
+            ThreadCache* pCache = GetCache();
+            if (pCache == nullptr) {
+                return;
+            }
+
+            DrainRemoteFrees(pCache);
+
+            bool bHasFreeChunk = false;
+            for (Chunk* pChunk = pCache->pChunks; pChunk != nullptr; pChunk = pChunk->pNext) {
+                if (pChunk->unLive == 0) {
+                    bHasFreeChunk = true;
+                    break;
+                }
+            }
+
+            if (bHasFreeChunk == false) {
+                return;
+            }
+
+            for (unsigned int unClass = 0; unClass < CLASS_COUNT; ++unClass) {
+                Block** ppLink = &pCache->pFreeLists[unClass];
+                while (*ppLink != nullptr) {
+                    if (ChunkOf(*ppLink)->unLive == 0) {
+                        *ppLink = (*ppLink)->pNext;
+                    }
+                    else {
+                        ppLink = &(*ppLink)->pNext;
+                    }
+                }
+            }
+
+            Chunk** ppChunk = &pCache->pChunks;
+            while (*ppChunk != nullptr) {
+                Chunk* pChunk = *ppChunk;
+                if (pChunk->unLive == 0) {
+                    *ppChunk = pChunk->pNext;
+                    FreeSystemAligned(pChunk);
+                }
+                else {
+                    ppChunk = &pChunk->pNext;
+                }
+            }
+        }
+
+    private:
+        enum {
+            BLOCK_ALIGNMENT = 16,
+            CLASS_GRANULARITY = 16,
+            CLASS_COUNT = PLNK_POOL_MAX_BLOCK_SIZE / CLASS_GRANULARITY
+        };
+
+        struct Chunk;
+        struct ThreadCache;
+
+        struct Block {
+            Block* pNext;
+        };
+
+        // Placed at the start of every chunk. The blocks follow it.
+        struct alignas(BLOCK_ALIGNMENT) Chunk {
+            ThreadCache* pOwner;
+            Chunk* pNext;
+            uint32_t unClass;
+            // Number of blocks handed out. Only the owner thread updates it.
+            uint32_t unLive;
+        };
+
+        struct ThreadCache {
+            Block* pFreeLists[CLASS_COUNT] = {};
+            Chunk* pChunks = nullptr;
+            std::atomic<Block*> pRemoteFrees{ nullptr };
+            std::atomic<bool> bOrphaned{ false };
+            ThreadCache* pNextCache = nullptr;
+        };
+
+        struct CacheSlot {
+            PlanetKitPoolAllocator* pPool = nullptr;
+            ThreadCache* pCache = nullptr;
+
+            ~CacheSlot() {
+                // The thread is exiting. Its cache, including the blocks it still owns, is handed to the next new thread.
+                if (pCache != nullptr) {
+                    pCache->bOrphaned.store(true, std::memory_order_release);
+                }
+            }
+        };
+
+        static CacheSlot& GetSlot() {
+            static thread_local CacheSlot s_slot;
+            return s_slot;
+        }
+
+        static unsigned int ClassOf(size_t size) {
+            return size == 0 ? 0 : (unsigned int)((size - 1) / CLASS_GRANULARITY);
+        }
+
+        static bool IsLarge(size_t size, size_t alignment) {
+            return size > PLNK_POOL_MAX_BLOCK_SIZE || alignment > BLOCK_ALIGNMENT;
+        }
+
+        static Chunk* ChunkOf(void* ptr) {
+            return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t)(PLNK_POOL_CHUNK_SIZE - 1));
+        }
+
+        static void* AllocateSystemAligned(size_t size, size_t alignment) {
+            // aligned_alloc requires a size that is a multiple of the alignment.
+            size_t nRounded = (size + alignment - 1) & ~(alignment - 1);
+            if (nRounded < size) {
+                return nullptr;
+            }
+#if defined(_WIN32)
+            return _aligned_malloc(nRounded, alignment);
+#else
+            return aligned_alloc(alignment, nRounded);
+#endif
+        }
+
+        static void FreeSystemAligned(void* ptr) {
+#if defined(_WIN32)
+            _aligned_free(ptr);
+#else
+            free(ptr);
+#endif
+        }
+
+        ThreadCache* GetCache() {
+            CacheSlot& slot = GetSlot();
+            if (slot.pPool == this) {
+                return slot.pCache;
+            }
+
+            if (slot.pCache != nullptr) {
+                // This thread switches to another pool, so its cache for the previous one is released for adoption.
+                slot.pCache->bOrphaned.store(true, std::memory_order_release);
+            }
+
+            ThreadCache* pCache = AdoptOrCreateCache();
+            slot.pPool = pCache != nullptr ? this : nullptr;
+            slot.pCache = pCache;
+            return pCache;
+        }
+
+        ThreadCache* AdoptOrCreateCache() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (ThreadCache* pCache = m_pCaches; pCache != nullptr; pCache = pCache->pNextCache) {
+                bool bOrphaned = true;
+                if (pCache->bOrphaned.compare_exchange_strong(bOrphaned, false, std::memory_order_acquire)) {
+                    return pCache;
+                }
+            }
+
+            void* pBuffer = AllocateSystemAligned(sizeof(ThreadCache), alignof(ThreadCache) < BLOCK_ALIGNMENT ? (size_t)BLOCK_ALIGNMENT : alignof(ThreadCache));
+            if (pBuffer == nullptr) {
+                return nullptr;
+            }
+
+            ThreadCache* pCache = new (pBuffer) ThreadCache();
+            pCache->pNextCache = m_pCaches;
+            m_pCaches = pCache;
+            return pCache;
+        }
+
+        static void DrainRemoteFrees(ThreadCache* pCache) {
+            Block* pBlock = pCache->pRemoteFrees.exchange(nullptr, std::memory_order_acquire);
+            while (pBlock != nullptr) {
+                Block* pNext = pBlock->pNext;
+                Chunk* pChunk = ChunkOf(pBlock);
+
+                pBlock->pNext = pCache->pFreeLists[pChunk->unClass];
+                pCache->pFreeLists[pChunk->unClass] = pBlock;
+                --pChunk->unLive;
+
+                pBlock = pNext;
+            }
+        }
+
+        static bool AddChunk(ThreadCache* pCache, unsigned int unClass) {
+            Chunk* pChunk = static_cast<Chunk*>(AllocateSystemAligned(PLNK_POOL_CHUNK_SIZE, PLNK_POOL_CHUNK_SIZE));
+            if (pChunk == nullptr) {
+                return false;
+            }
+
+            pChunk->pOwner = pCache;
+            pChunk->pNext = pCache->pChunks;
+            pChunk->unClass = unClass;
+            pChunk->unLive = 0;
+            pCache->pChunks = pChunk;
+
+            size_t nStride = (unClass + 1) * CLASS_GRANULARITY;
+            unsigned char* pPos = reinterpret_cast<unsigned char*>(pChunk + 1);
+            unsigned char* pEnd = reinterpret_cast<unsigned char*>(pChunk) + PLNK_POOL_CHUNK_SIZE;
+
+            Block* pHead = pCache->pFreeLists[unClass];
+            for (; pPos + nStride <= pEnd; pPos += nStride) {
+                Block* pBlock = reinterpret_cast<Block*>(pPos);
+                pBlock->pNext = pHead;
+                pHead = pBlock;
+            }
+            pCache->pFreeLists[unClass] = pHead;
+
+            return true;
+        }
+
+        std::mutex m_mutex;
+        ThreadCache* m_pCaches = nullptr;
+    };
+};
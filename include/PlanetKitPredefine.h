@@ -14,11 +14,42 @@
 
 #pragma once
 
+#if defined(_WIN32)
 #include <Windows.h>
+#else
+#include <stddef.h>
+#include <string.h>
+#include <wchar.h>
+#endif
 #include <stdint.h>
+#include <new>
 
 #ifdef PLANETKIT_EXPORTS
+#if defined(_WIN32)
 #define PLANETKIT_API __declspec(dllexport)
 #else
+#define PLANETKIT_API __attribute__((visibility("default")))
+#endif
+#else
 #define PLANETKIT_API
+#endif
+
+#if !defined(_WIN32)
+// Minimal stand-ins for the Win32 types used by the headers, so that the header templates can be built and
+// measured on other platforms. They are not part of the SDK interface.
+typedef int BOOL;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef unsigned char BYTE;
+typedef uint64_t UINT64;
+typedef void* HWND;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+static_assert(sizeof(LONG) == 4 && sizeof(ULONG) == 4, "LONG and ULONG are 32-bit as on Windows");
 #endif
\ No newline at end of file
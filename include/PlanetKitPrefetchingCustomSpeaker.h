@@ -0,0 +1,322 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "PlanetKitCustomSpeaker.h"
+
+namespace PlanetKit {
+    /**
+     * Configuration of PrefetchingCustomSpeaker
+     */
+    typedef struct SPrefetchingSpeakerConfig {
+        /// Sampling rate requested from the session
+        unsigned int unSamplingRate = 48000;
+        /// Sample format requested from the session
+        EAudioDataSampleType eSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+        /// Length of one pull from the session in milliseconds
+        unsigned int unPullFrameMs = 10;
+        /// Audio kept ahead in milliseconds when no jitter has been observed yet
+        unsigned int unInitialTargetMs = 20;
+        /// Lower bound of the adaptive target
+        unsigned int unMinTargetMs = 10;
+        /// Upper bound of the adaptive target. The ring is sized for this plus one pull.
+        unsigned int unMaxTargetMs = 100;
+        /// Adapts the target to the observed jitter of PullAudioData calls and to underruns, once the session delivers audio
+        bool bAdaptiveTarget = true;
+    } SPrefetchingSpeakerConfig;
+
+    /**
+     * Counters of PrefetchingCustomSpeaker
+     */
+    typedef struct SPrefetchingSpeakerStatistics {
+        /// PullAudioData calls that found less audio than requested. The rest is filled with silence.
+        uint64_t ullUnderruns;
+        /// Audio currently buffered in milliseconds
+        unsigned int unFillMs;
+        /// Current target in milliseconds
+        unsigned int unTargetMs;
+    } SPrefetchingSpeakerStatistics;
+
+    /**
+     * Custom speaker that pulls audio from the session ahead of time.
+     * @remark
+     *   Start() runs a background thread that calls CustomSpeaker::PullAudioData in unPullFrameMs steps and keeps the
+     *   target amount of PCM in a single-producer/single-consumer byte ring. The output thread calls PullAudioData, which
+     *   then only copies from the ring, so late delivery from the session does not make the output device underrun.<br>
+     *   With bAdaptiveTarget the target follows the worst recent deviation of the output thread's call interval from the
+     *   requested duration, and grows by one pull after every underrun. It decays back slowly while playback is smooth.
+     *   The target is left alone while the session delivers nothing, for example before a speaker event is registered.<br>
+     *   PullAudioData must be called from a single thread, with the configured sampling rate and sample format.<br>
+     *   If the ring cannot be allocated, Start() and PullAudioData() return false.
+     */
+    class PrefetchingCustomSpeaker : public CustomSpeaker {
+    public:
+        explicit PrefetchingCustomSpeaker(const SPrefetchingSpeakerConfig& sConfig = SPrefetchingSpeakerConfig()) : m_sConfig(sConfig) {
+            if (m_sConfig.unPullFrameMs == 0) {
+                m_sConfig.unPullFrameMs = 10;
+            }
+            if (m_sConfig.unMaxTargetMs < m_sConfig.unMinTargetMs) {
+                m_sConfig.unMaxTargetMs = m_sConfig.unMinTargetMs;
+            }
+
+            m_unPullSamples = (unsigned int)((uint64_t)m_sConfig.unSamplingRate * m_sConfig.unPullFrameMs / 1000);
+            m_unPullBytes = m_unPullSamples * BytesPerSample(m_sConfig.eSampleFormat);
+            m_nCapacity = BytesOf(m_sConfig.unMaxTargetMs) + m_unPullBytes;
+
+            m_pRing = static_cast<unsigned char*>(PlanetKitMemory::AllocateArrayMemory(m_nCapacity));
+            m_pPullBuffer = static_cast<unsigned char*>(PlanetKitMemory::AllocateArrayMemory(m_unPullBytes));
+            if (m_pRing == nullptr || m_pPullBuffer == nullptr) {
+                if (m_pRing) {
+                    PlanetKitMemory::FreeArrayMemory(m_pRing);
+                    m_pRing = nullptr;
+                }
+                if (m_pPullBuffer) {
+                    PlanetKitMemory::FreeArrayMemory(m_pPullBuffer);
+                    m_pPullBuffer = nullptr;
+                }
+                m_nCapacity = 0;
+            }
+
+            m_unTargetMs.store(Clamp(m_sConfig.unInitialTargetMs), std::memory_order_relaxed);
+        }
+
+        PrefetchingCustomSpeaker(const PrefetchingCustomSpeaker&) = delete;
+        PrefetchingCustomSpeaker& operator=(const PrefetchingCustomSpeaker&) = delete;
+
+        virtual ~PrefetchingCustomSpeaker() {
+            Stop();
+
+            if (m_pPullBuffer) {
+                PlanetKitMemory::FreeArrayMemory(m_pPullBuffer);
+            }
+            if (m_pRing) {
+                PlanetKitMemory::FreeArrayMemory(m_pRing);
+            }
+        }
+
+        /**
+         * Starts the background puller.
+         * @return false if it is already running or the ring could not be allocated.
+         */
+        bool Start() {
+            if (m_thread.joinable() || m_pRing == nullptr) {
+                return false;
+            }
+
+            m_bStop.store(false, std::memory_order_relaxed);
+            m_thread = std::thread(&PrefetchingCustomSpeaker::PullLoop, this);
+            return true;
+        }
+
+        /**
+         * Stops the background puller. Buffered audio can still be read.
+         */
+        void Stop() {
+            if (m_thread.joinable()) {
+                m_bStop.store(true, std::memory_order_relaxed);
+                m_thread.join();
+            }
+        }
+
+        /**
+         * Reads buffered audio data for the output device.
+         * @param audioData unAudioDataSampleCount samples are written to ucBuffer, which must hold unBufferSize bytes.
+         *   unBufferSize is set to the number of bytes written.
+         * @return false if the sampling rate or sample format differs from the configuration, the buffer is too small,
+         *   or the ring could not be allocated.
+         * @remark Missing audio is filled with silence and counted as an underrun.
+         */
+        virtual bool PullAudioData(SAudioData& audioData) override {
+            if (m_pRing == nullptr) {
+                return false;
+            }
+
+            if (audioData.unAudioDataSamplingRate != m_sConfig.unSamplingRate || audioData.eAudioDataSampleFormat != m_sConfig.eSampleFormat) {
+                return false;
+            }
+
+            size_t nBytes = (size_t)audioData.unAudioDataSampleCount * BytesPerSample(m_sConfig.eSampleFormat);
+            if (nBytes > audioData.unBufferSize) {
+                return false;
+            }
+
+            uint64_t ullRead = m_ullRead.load(std::memory_order_relaxed);
+            size_t nAvailable = (size_t)(m_ullWrite.load(std::memory_order_acquire) - ullRead);
+            size_t nCopy = nAvailable < nBytes ? nAvailable : nBytes;
+
+            CopyFromRing(audioData.ucBuffer, ullRead, nCopy);
+            m_ullRead.store(ullRead + nCopy, std::memory_order_release);
+
+            if (nCopy < nBytes) {
+                memset(audioData.ucBuffer + nCopy, 0, nBytes - nCopy);
+                m_ullUnderruns.fetch_add(1, std::memory_order_relaxed);
+            }
+            audioData.unBufferSize = (unsigned int)nBytes;
+
+            if (m_sConfig.bAdaptiveTarget) {
+                if (m_bSessionDelivering.load(std::memory_order_relaxed)) {
+                    Adapt(audioData.unAudioDataSampleCount, nCopy < nBytes);
+                }
+                else {
+                    // Underruns are expected until the session delivers, and the gap must not count as jitter afterwards.
+                    m_bHasLastPull = false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Gets a snapshot of the counters. Can be called from any thread.
+         */
+        void GetStatistics(SPrefetchingSpeakerStatistics& sStatistics) const {
+            sStatistics.ullUnderruns = m_ullUnderruns.load(std::memory_order_relaxed);
+            sStatistics.unFillMs = (unsigned int)((uint64_t)Fill() / BytesPerSample(m_sConfig.eSampleFormat) * 1000 / (m_sConfig.unSamplingRate ? m_sConfig.unSamplingRate : 1));
+            sStatistics.unTargetMs = m_unTargetMs.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static unsigned int BytesPerSample(EAudioDataSampleType eFormat) {
+            return eFormat == PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32 ? 4 : 2;
+        }
+
+        /**
+         * Bytes of unMs milliseconds of audio, in whole samples, so that rates such as 44.1 kHz are not truncated to 44 samples per ms.
+         */
+        size_t BytesOf(unsigned int unMs) const {
+            return (size_t)((uint64_t)unMs * m_sConfig.unSamplingRate / 1000) * BytesPerSample(m_sConfig.eSampleFormat);
+        }
+
+        unsigned int Clamp(unsigned int unMs) const {
+            return unMs < m_sConfig.unMinTargetMs ? m_sConfig.unMinTargetMs : unMs > m_sConfig.unMaxTargetMs ? m_sConfig.unMaxTargetMs : unMs;
+        }
+
+        size_t Fill() const {
+            return (size_t)(m_ullWrite.load(std::memory_order_acquire) - m_ullRead.load(std::memory_order_acquire));
+        }
+
+        void PullLoop() {
+            std::chrono::milliseconds idle(m_sConfig.unPullFrameMs / 2 ? m_sConfig.unPullFrameMs / 2 : 1);
+
+            while (m_bStop.load(std::memory_order_relaxed) == false) {
+                size_t nTarget = BytesOf(m_unTargetMs.load(std::memory_order_relaxed));
+                if (Fill() >= nTarget) {
+                    std::this_thread::sleep_for(idle);
+                    continue;
+                }
+
+                SAudioData audioData;
+                audioData.unAudioDataSamplingRate = m_sConfig.unSamplingRate;
+                audioData.unAudioDataSampleCount = m_unPullSamples;
+                audioData.eAudioDataSampleFormat = m_sConfig.eSampleFormat;
+                audioData.ucBuffer = m_pPullBuffer;
+                audioData.unBufferSize = m_unPullBytes;
+
+                if (CustomSpeaker::PullAudioData(audioData) == false) {
+                    // Nothing to play yet, for example before an event is registered.
+                    m_bSessionDelivering.store(false, std::memory_order_relaxed);
+                    std::this_thread::sleep_for(idle);
+                    continue;
+                }
+                m_bSessionDelivering.store(true, std::memory_order_relaxed);
+
+                // The fill was below the target, which is at most unMaxTargetMs, and the ring holds that plus one pull.
+                size_t nBytes = audioData.unBufferSize < m_unPullBytes ? audioData.unBufferSize : m_unPullBytes;
+                uint64_t ullWrite = m_ullWrite.load(std::memory_order_relaxed);
+                assert(m_nCapacity - (size_t)(ullWrite - m_ullRead.load(std::memory_order_acquire)) >= nBytes);
+
+                CopyToRing(ullWrite, m_pPullBuffer, nBytes);
+                m_ullWrite.store(ullWrite + nBytes, std::memory_order_release);
+            }
+        }
+
+        void CopyToRing(uint64_t ullPos, const unsigned char* pSrc, size_t nBytes) {
+            size_t nOffset = (size_t)(ullPos % m_nCapacity);
+            size_t nFirst = m_nCapacity - nOffset < nBytes ? m_nCapacity - nOffset : nBytes;
+            memcpy(m_pRing + nOffset, pSrc, nFirst);
+            memcpy(m_pRing, pSrc + nFirst, nBytes - nFirst);
+        }
+
+        void CopyFromRing(unsigned char* pDst, uint64_t ullPos, size_t nBytes) const {
+            size_t nOffset = (size_t)(ullPos % m_nCapacity);
+            size_t nFirst = m_nCapacity - nOffset < nBytes ? m_nCapacity - nOffset : nBytes;
+            memcpy(pDst, m_pRing + nOffset, nFirst);
+            memcpy(pDst + nFirst, m_pRing, nBytes - nFirst);
+        }
+
+        /**
+         * Runs on the output thread. Tracks the worst deviation of the call interval from the played duration with a slow
+         * decay, and keeps the target at one pull plus twice that deviation.
+         */
+        void Adapt(unsigned int unSampleCount, bool bUnderrun) {
+            typedef std::chrono::steady_clock Clock;
+
+            Clock::time_point now = Clock::now();
+            if (m_bHasLastPull) {
+                int64_t llElapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastPull).count();
+                int64_t llExpectedUs = (int64_t)m_unLastSampleCount * 1000000 / m_sConfig.unSamplingRate;
+                int64_t llDeviationUs = llElapsedUs > llExpectedUs ? llElapsedUs - llExpectedUs : llExpectedUs - llElapsedUs;
+
+                // Peak hold that halves in about 700 calls.
+                m_llJitterUs -= m_llJitterUs / 1024;
+                if (llDeviationUs > m_llJitterUs) {
+                    m_llJitterUs = llDeviationUs;
+                }
+            }
+            m_lastPull = now;
+            m_unLastSampleCount = unSampleCount;
+            m_bHasLastPull = true;
+
+            if (bUnderrun) {
+                // Half a pull of jitter, since the target counts the jitter twice.
+                m_llJitterUs += (int64_t)m_sConfig.unPullFrameMs * 500;
+            }
+
+            unsigned int unTargetMs = Clamp(m_sConfig.unPullFrameMs + (unsigned int)(2 * m_llJitterUs / 1000));
+            m_unTargetMs.store(unTargetMs, std::memory_order_relaxed);
+        }
+
+        SPrefetchingSpeakerConfig m_sConfig;
+        unsigned int m_unPullSamples = 0;
+        unsigned int m_unPullBytes = 0;
+
+        unsigned char* m_pRing = nullptr;
+        size_t m_nCapacity = 0;
+        unsigned char* m_pPullBuffer = nullptr;
+
+        std::atomic<uint64_t> m_ullWrite{ 0 };
+        std::atomic<uint64_t> m_ullRead{ 0 };
+        std::atomic<unsigned int> m_unTargetMs{ 0 };
+
+        std::atomic<uint64_t> m_ullUnderruns{ 0 };
+        std::atomic<bool> m_bSessionDelivering{ false };
+
+        // Output thread only
+        std::chrono::steady_clock::time_point m_lastPull;
+        unsigned int m_unLastSampleCount = 0;
+        int64_t m_llJitterUs = 0;
+        bool m_bHasLastPull = false;
+
+        std::atomic<bool> m_bStop{ false };
+        std::thread m_thread;
+    };
+}
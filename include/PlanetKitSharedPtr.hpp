@@ -15,10 +15,16 @@
 #pragma once
 
 #include "PlanetKitControlBlock.hpp"
-#include <windows.h>
 #include <assert.h>
+#include <utility>
 
 namespace PlanetKit {
+    template <typename T, typename RefCountPolicy>
+    class WeakPtr;
+
+    template <typename T>
+    class AtomicSharedPtr;
+
     template <typename T>
     class PLANETKIT_API SharedPtr {
     public:
@@ -29,6 +35,10 @@ namespace PlanetKit {
             copy(other);
         }
 
+        SharedPtr(SharedPtr&& other) : control_block_(other.control_block_) {
+            other.control_block_ = nullptr;
+        }
+
         template <typename U>
         SharedPtr(const SharedPtr<U>& other) : control_block_(reinterpret_cast<ControlBlock<T>*>(other.control_block_)) {
             if (control_block_) {
@@ -36,6 +46,11 @@ namespace PlanetKit {
             }
         }
 
+        template <typename U>
+        SharedPtr(SharedPtr<U>&& other) : control_block_(reinterpret_cast<ControlBlock<T>*>(other.control_block_)) {
+            other.control_block_ = nullptr;
+        }
+
         SharedPtr& operator=(const SharedPtr& other) {
             if (this != &other) {
                 release();
@@ -44,6 +59,15 @@ namespace PlanetKit {
             return *this;
         }
 
+        SharedPtr& operator=(SharedPtr&& other) {
+            if (this != &other) {
+                release();
+                control_block_ = other.control_block_;
+                other.control_block_ = nullptr;
+            }
+            return *this;
+        }
+
         SharedPtr& operator=(std::nullptr_t) {
             release();
             control_block_ = nullptr;
@@ -108,6 +132,8 @@ namespace PlanetKit {
             control_block_ = pBuffer;
         }
 
+        explicit SharedPtr(ControlBlock<T>* pControlBlock) : control_block_(pControlBlock) {}
+
         void release() {
             if (control_block_) {
                 control_block_->release();
@@ -129,15 +155,185 @@ namespace PlanetKit {
         template <typename U>
         friend class SharedPtr;
 
-        template <typename T, typename... Args>
-        friend SharedPtr<T> MakeAutoPtr(Args&&... args);
+        template <typename U>
+        friend class AtomicSharedPtr;
+
+        template <typename U, typename... Args>
+        friend SharedPtr<U> MakeAutoPtr(Args&&... args);
     };
 
+    /**
+     * Creates T, forwarding args to its constructor, and a SharedPtr that manages it.
+     */
     template <typename T, typename... Args>
     SharedPtr<T> MakeAutoPtr(Args&&... args) {
         T* ptr = static_cast<T*>(PlanetKitMemory::AllocateMemory(sizeof(T)));
-        new (ptr) T(args...);
+        new (ptr) T(std::forward<Args>(args)...);
 
         return SharedPtr<T>(ptr);
     }
+
+    /**
+     * Reference counted smart pointer whose object is stored inside its control block, so that both take a single allocation.
+     * @remark
+     *   Use it for objects that stay on the application side, for example per-session state that is created and dropped often.<br>
+     *   It cannot be converted to SharedPtr, because the SDK releases SharedPtr control blocks with its own code. Pass SharedPtr,
+     *   created with MakeAutoPtr, wherever the SDK takes ownership.
+     */
+    template <typename T, typename RefCountPolicy = AtomicRefCountPolicy>
+    class InplaceSharedPtr {
+    public:
+        InplaceSharedPtr() : ptr_(nullptr), control_block_(nullptr) {}
+        InplaceSharedPtr(std::nullptr_t) : ptr_(nullptr), control_block_(nullptr) {}
+
+        InplaceSharedPtr(const InplaceSharedPtr& other) {
+            copy(other.ptr_, other.control_block_);
+        }
+
+        InplaceSharedPtr(InplaceSharedPtr&& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+            other.ptr_ = nullptr;
+            other.control_block_ = nullptr;
+        }
+
+        template <typename U>
+        InplaceSharedPtr(const InplaceSharedPtr<U, RefCountPolicy>& other) {
+            copy(other.ptr_, other.control_block_);
+        }
+
+        template <typename U>
+        InplaceSharedPtr(InplaceSharedPtr<U, RefCountPolicy>&& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+            other.ptr_ = nullptr;
+            other.control_block_ = nullptr;
+        }
+
+        InplaceSharedPtr& operator=(const InplaceSharedPtr& other) {
+            if (this != &other) {
+                release();
+                copy(other.ptr_, other.control_block_);
+            }
+            return *this;
+        }
+
+        InplaceSharedPtr& operator=(InplaceSharedPtr&& other) {
+            if (this != &other) {
+                release();
+                ptr_ = other.ptr_;
+                control_block_ = other.control_block_;
+                other.ptr_ = nullptr;
+                other.control_block_ = nullptr;
+            }
+            return *this;
+        }
+
+        InplaceSharedPtr& operator=(std::nullptr_t) {
+            release();
+            return *this;
+        }
+
+        ~InplaceSharedPtr() {
+            release();
+        }
+
+        bool hasValue() const {
+            return ptr_ ? true : false;
+        }
+
+        T& operator*() const {
+            return *ptr_;
+        }
+
+        T* operator->() const {
+            return ptr_;
+        }
+
+        bool operator==(const InplaceSharedPtr& other) const {
+            return ptr_ == other.ptr_;
+        }
+
+        bool operator!=(const InplaceSharedPtr& other) const {
+            return !(*this == other);
+        }
+
+        bool operator==(std::nullptr_t) const {
+            return ptr_ == nullptr;
+        }
+
+        bool operator!=(std::nullptr_t) const {
+            return ptr_ != nullptr;
+        }
+
+        bool operator<(const InplaceSharedPtr& other) const {
+            return control_block_ < other.control_block_;
+        }
+
+        template <typename U>
+        InplaceSharedPtr<U, RefCountPolicy> as() const {
+            U* castedPtr = dynamic_cast<U*>(ptr_);
+            if (castedPtr) {
+                control_block_->addRef();
+                return InplaceSharedPtr<U, RefCountPolicy>(castedPtr, control_block_);
+            }
+            return InplaceSharedPtr<U, RefCountPolicy>();
+        }
+
+    private:
+        /**
+         * Takes over a reference that the caller already holds.
+         */
+        InplaceSharedPtr(T* ptr, InplaceControlBlockBase<RefCountPolicy>* pControlBlock) : ptr_(ptr), control_block_(pControlBlock) {}
+
+        void release() {
+            if (control_block_) {
+                control_block_->release();
+                control_block_ = nullptr;
+            }
+            ptr_ = nullptr;
+        }
+
+        void copy(T* ptr, InplaceControlBlockBase<RefCountPolicy>* pControlBlock) {
+            ptr_ = ptr;
+            control_block_ = pControlBlock;
+            if (control_block_) {
+                control_block_->addRef();
+            }
+        }
+
+        T* ptr_;
+        InplaceControlBlockBase<RefCountPolicy>* control_block_;
+
+        template <typename U, typename P>
+        friend class InplaceSharedPtr;
+
+        template <typename U, typename P>
+        friend class WeakPtr;
+
+        template <typename U, typename P, typename... Args>
+        friend InplaceSharedPtr<U, P> MakeInplaceAutoPtr(Args&&... args);
+    };
+
+    /**
+     * Creates T and its control block in a single allocation, forwarding args to the constructor of T.
+     */
+    template <typename T, typename RefCountPolicy = AtomicRefCountPolicy, typename... Args>
+    InplaceSharedPtr<T, RefCountPolicy> MakeInplaceAutoPtr(Args&&... args) {
+        InplaceControlBlock<T, RefCountPolicy>* pBuffer = static_cast<InplaceControlBlock<T, RefCountPolicy>*>(PlanetKitMemory::AllocateMemory(sizeof(InplaceControlBlock<T, RefCountPolicy>)));
+        new (pBuffer) InplaceControlBlock<T, RefCountPolicy>(std::forward<Args>(args)...);
+
+        return InplaceSharedPtr<T, RefCountPolicy>(pBuffer->getPtr(), pBuffer);
+    }
+
+    /**
+     * InplaceSharedPtr for objects that are only ever used on one thread. Its reference count is not atomic.
+     */
+    template <typename T>
+    using LocalSharedPtr = InplaceSharedPtr<T, SingleThreadRefCountPolicy>;
+
+    /**
+     * Creates T and its single-threaded control block in a single allocation, forwarding args to the constructor of T.
+     * @remark The returned pointer and every copy of it must stay on the creating thread.
+     */
+    template <typename T, typename... Args>
+    LocalSharedPtr<T> MakeLocalAutoPtr(Args&&... args) {
+        return MakeInplaceAutoPtr<T, SingleThreadRefCountPolicy>(std::forward<Args>(args)...);
+    }
 };
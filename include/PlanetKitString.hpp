@@ -15,15 +15,18 @@
 #pragma once
 
 #include <string.h>
+#include <wchar.h>
+#include <utility>
 
 #include "PlanetKitPredefine.h"
 #include "PlanetKitMemory.h"
 
+#ifdef _MSC_VER
 #pragma warning(push)
 
 // Disable warning: multiple copy constructors specified
 #pragma warning(disable: 4521)
-
+#endif
 
 namespace PlanetKit {
     class PLANETKIT_API String {
@@ -44,35 +47,42 @@ namespace PlanetKit {
          * Create with string
          */
         String(String& src) {
-            Copy(src.c_str());
+            Assign(src.m_pData, src.m_nSize);
         }
 
         /**
          * Create with string
          */
         String(const String& src) {
-            Copy(src.c_str());
+            Assign(src.m_pData, src.m_nSize);
+        }
+
+        /**
+         * Create by taking over the buffer of src
+         */
+        String(String&& src) {
+            MoveFrom(src);
         }
 
         /**
          * Normal destructor
          */
         virtual ~String() {
-            Clear();
+            ReleaseBuffer();
         }
 
         /**
          * const char* operator
          */
         operator const char*() const {
-            return m_pData;
+            return c_str();
         }
 
         /**
          * Get string value
          */
         const char* c_str() const {
-            return m_pData;
+            return m_pData ? m_pData : "";
         }
 
         /**
@@ -95,25 +105,18 @@ namespace PlanetKit {
          * Compare between string
          */
         bool operator==(const char* rhs) const {
-            if (m_pData == nullptr && rhs == nullptr) {
-                return true;
+            if (rhs == nullptr) {
+                return m_nSize == 0;
             }
-            if (rhs) {
-                size_t nLen = strlen(rhs);
-
-                if (m_nSize != nLen) {
-                    return false;
-                }
-                else if (m_nSize == 0 && nLen == 0) {
-                    return true;
-                }
 
-                if (strcmp(m_pData, rhs) == 0) {
-                    return true;
-                }
-            }
+            return strcmp(c_str(), rhs) == 0;
+        }
 
-            return false;
+        /**
+         * Compare between string
+         */
+        bool operator==(const String& rhs) const {
+            return m_nSize == rhs.m_nSize && (m_nSize == 0 || memcmp(m_pData, rhs.m_pData, m_nSize) == 0);
         }
 
         /**
@@ -129,7 +132,21 @@ namespace PlanetKit {
          * Set string
          */
         String& operator=(const String& src) {
-            Copy(src);
+            if (this != &src) {
+                Assign(src.m_pData, src.m_nSize);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Set string by taking over the buffer of src
+         */
+        String& operator=(String&& src) {
+            if (this != &src) {
+                ReleaseBuffer();
+                MoveFrom(src);
+            }
 
             return *this;
         }
@@ -147,27 +164,21 @@ namespace PlanetKit {
          * Copy string
          */
         void Copy(const char* src) {
-            Clear();
-
-            if (src) {
-                m_nSize = strlen(src);
-
-                if (m_nSize > 0) {
-                    m_pData = static_cast<char*>(PlanetKitMemory::AllocateArrayMemory(m_nSize + 1));
-                    strcpy_s(m_pData, m_nSize + 1, src);
-                }
+            if (src != nullptr && src == m_pData) {
+                return;
             }
+
+            Assign(src, src ? strlen(src) : 0);
         }
 
         /**
          * Clear string
          */
         void Clear() {
-            if (m_pData && m_nSize) {
-                PlanetKitMemory::FreeArrayMemory(m_pData);
-                m_pData = nullptr;
-                m_nSize = 0;
-            }
+            ReleaseBuffer();
+
+            m_pData = nullptr;
+            m_nSize = 0;
         }
 
         /**
@@ -175,16 +186,68 @@ namespace PlanetKit {
          */
         void AppendData(const char* rhs) {
             if (rhs != nullptr) {
-                size_t nLen = strlen(rhs);
+                AppendData(rhs, strlen(rhs));
+            }
+        }
 
-                char* pTemp = m_pData;
+        /**
+         * Append nLen characters of rhs
+         */
+        void AppendData(const char* rhs, size_t nLen) {
+            if (nLen == 0) {
+                return;
+            }
 
-                m_nSize += nLen;
-                m_pData = static_cast<char*>(PlanetKitMemory::AllocateArrayMemory(m_nSize + 1));
-                strcpy_s(m_pData, m_nSize + 1, pTemp);
-                strcat_s(m_pData, m_nSize + 1, rhs);
+            size_t nNewSize = m_nSize + nLen;
 
-                PlanetKitMemory::FreeArrayMemory(pTemp);
+            // rhs may point into this string, so it is copied before the old buffer is released.
+            char* pBuffer = static_cast<char*>(PlanetKitMemory::AllocateArrayMemory(nNewSize + 1));
+            if (m_nSize > 0) {
+                memcpy(pBuffer, m_pData, m_nSize);
+            }
+            memcpy(pBuffer + m_nSize, rhs, nLen);
+            pBuffer[nNewSize] = '\0';
+
+            ReleaseBuffer();
+            m_pData = pBuffer;
+            m_nSize = nNewSize;
+        }
+
+    private:
+        void Assign(const char* src, size_t nLen) {
+            if (nLen == 0) {
+                // The SDK binary only releases a String buffer while Size() is non-zero, so an empty String holds none.
+                Clear();
+                return;
+            }
+
+            // The buffer holds at least Size() + 1 characters, so it is reused when the new value fits.
+            if (m_pData == nullptr || nLen > m_nSize) {
+                char* pBuffer = static_cast<char*>(PlanetKitMemory::AllocateArrayMemory(nLen + 1));
+                memcpy(pBuffer, src, nLen);
+
+                ReleaseBuffer();
+                m_pData = pBuffer;
+            }
+            else {
+                memmove(m_pData, src, nLen);
+            }
+
+            m_pData[nLen] = '\0';
+            m_nSize = nLen;
+        }
+
+        void MoveFrom(String& src) {
+            m_pData = src.m_pData;
+            m_nSize = src.m_nSize;
+
+            src.m_pData = nullptr;
+            src.m_nSize = 0;
+        }
+
+        void ReleaseBuffer() {
+            if (m_pData) {
+                PlanetKitMemory::FreeArrayMemory(m_pData);
             }
         }
 
@@ -193,6 +256,9 @@ namespace PlanetKit {
         size_t m_nSize = 0;
     };
 
+    // String is exchanged with the SDK binary, which was built with this layout.
+    static_assert(sizeof(String) == sizeof(void*) + sizeof(char*) + sizeof(size_t), "String must keep the layout of the SDK binary");
+
     class PLANETKIT_API WString {
     public:
         /**
@@ -213,35 +279,43 @@ namespace PlanetKit {
          * Create with string
          */
         WString(WString& src) {
-            Copy(src.c_str());
+            Assign(src.m_pData, src.m_nSize);
         }
 
         /**
          * Create with string
          */
         WString(const WString& src) {
-            Copy(src.c_str());
+            Assign(src.m_pData, src.m_nSize);
+        }
+
+        /**
+         * Create by taking over the buffer of src
+         */
+        WString(WString&& src) {
+            MoveFrom(src);
         }
 
         /**
          * Normal destructor
          */
         virtual ~WString() {
-            Clear();
+            ReleaseBuffer();
         }
 
         /**
          * const char* operator
          */
         operator const wchar_t*() const {
-            return m_pData;
+            return c_str();
         }
 
         /**
          * Get string value
          */
         const wchar_t* c_str() const {
-            return m_pData;
+            // Only a moved-from WString has no buffer.
+            return m_pData ? m_pData : L"";
         }
 
         /**
@@ -261,61 +335,43 @@ namespace PlanetKit {
         }
 
         /**
-         * Compare between string
+         * Append nLen characters of rhs
          */
-        bool operator==(const wchar_t* rhs) const {
-            if (m_nSize == 0 && rhs == nullptr) {
-                return true;
-            }
-
-            if (rhs) {
-                size_t nLen = wcslen(rhs);
+        WString& Append(const wchar_t* rhs, size_t nLen) {
+            AppendData(rhs, nLen);
 
-                if (m_nSize != nLen) {
-                    return false;
-                }
+            return *this;
+        }
 
-                if (m_nSize == 0 && nLen == 0) {
-                    return true;
-                }
-                else  if (wcscmp(m_pData, rhs) == 0) {
-                    return true;
-                }
+        /**
+         * Clear string. The buffer is kept.
+         */
+        void Empty() {
+            if (m_pData == nullptr) {
+                Initialize();
             }
 
-            return false;
+            m_pData[0] = L'\0';
+            m_nSize = 0;
         }
 
-        bool operator==(const WString& rhs) const {
-            if (m_nSize == 0 && rhs.Size() == 0) {
-                return true;
-            }
-
-            if (this->Size() != rhs.Size()) {
-                return false;
+        /**
+         * Compare between string
+         */
+        bool operator==(const wchar_t* rhs) const {
+            if (rhs == nullptr) {
+                return m_nSize == 0;
             }
 
-            if (wcscmp(m_pData, rhs.c_str()) == 0) {
-                return true;
-            }
+            return wcscmp(c_str(), rhs) == 0;
+        }
 
-            return false;
+        bool operator==(const WString& rhs) const {
+            return m_nSize == rhs.m_nSize && (m_nSize == 0 || wmemcmp(m_pData, rhs.m_pData, m_nSize) == 0);
         }
 
         bool operator!=(const WString& rhs) const {
-            if (m_nSize == 0 && rhs.Size() == 0) {
-                return false;
-            }
-
-            if (this->Size() != rhs.Size()) {
-                return true;
-            }
-
-            if (wcscmp(m_pData, rhs.c_str()) == 0) {
-                return false;
-            }
-
-            return true;
+            return !(*this == rhs);
         }
 
 
@@ -341,7 +397,21 @@ namespace PlanetKit {
          * Set string
          */
         WString& operator=(const WString& src) {
-            Copy(src);
+            if (this != &src) {
+                Assign(src.m_pData, src.m_nSize);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Set string by taking over the buffer of src
+         */
+        WString& operator=(WString&& src) {
+            if (this != &src) {
+                ReleaseBuffer();
+                MoveFrom(src);
+            }
 
             return *this;
         }
@@ -359,7 +429,7 @@ namespace PlanetKit {
          * Append string
          */
         WString& operator+=(const WString& rhs) {
-            AppendData(rhs.c_str());
+            AppendData(rhs.m_pData, rhs.m_nSize);
 
             return *this;
         }
@@ -375,10 +445,9 @@ namespace PlanetKit {
                 return strTemp;  // Return empty string for out-of-bounds start
             }
             
-            wchar_t* pstrChar = m_pData + unStart;
             if (unLength == 0) {
                 // Take substring from unStart to end of string
-                strTemp = pstrChar;
+                strTemp.Assign(m_pData + unStart, m_nSize - unStart);
                 return strTemp;
             }
             else {
@@ -392,12 +461,7 @@ namespace PlanetKit {
                     return strTemp;  // Return empty string for range that would exceed bounds
                 }
                 else {
-                    wchar_t charTemp = m_pData[unStart + unLength];
-                    m_pData[unStart + unLength] = L'\0';
-
-                    strTemp = pstrChar;
-                    m_pData[unStart + unLength] = charTemp;
-
+                    strTemp.Assign(m_pData + unStart, unLength);
                     return strTemp;
                 }
             }
@@ -426,26 +490,32 @@ namespace PlanetKit {
              * Copy string
              */
             void Copy(const wchar_t* src) {
-                if (*this == src) {
+                if (src != nullptr && src == m_pData) {
                     return;
                 }
 
-                Clear();
-
-                if (src && wcslen(src) > 0) {
-                    m_nSize = wcslen(src);
+                Assign(src, src ? wcslen(src) : 0);
+            }
 
-                    if (m_nSize > 0) {
-                        m_pData = static_cast<wchar_t*>(PlanetKitMemory::AllocateArrayMemory((m_nSize + 1) * sizeof(wchar_t)));
-                        wcscpy_s(m_pData, m_nSize + 1, src);
-                    }
-                    else {
-                        Initialize();
+            /**
+             * Copy nLen characters of src. The buffer holds at least Size() + 1 characters, so it is reused when the new value fits.
+             */
+            void Assign(const wchar_t* src, size_t nLen) {
+                if (m_pData == nullptr || nLen > m_nSize) {
+                    wchar_t* pBuffer = static_cast<wchar_t*>(PlanetKitMemory::AllocateArrayMemory((nLen + 1) * sizeof(wchar_t)));
+                    if (nLen > 0) {
+                        wmemcpy(pBuffer, src, nLen);
                     }
+
+                    ReleaseBuffer();
+                    m_pData = pBuffer;
                 }
-                else {
-                    Initialize();
+                else if (nLen > 0) {
+                    wmemmove(m_pData, src, nLen);
                 }
+
+                m_pData[nLen] = L'\0';
+                m_nSize = nLen;
             }
 
             /**
@@ -453,31 +523,44 @@ namespace PlanetKit {
              */
             void AppendData(const wchar_t* rhs) {
                 if (rhs != nullptr) {
-                    size_t nLen = wcslen(rhs);
+                    AppendData(rhs, wcslen(rhs));
+                }
+            }
 
-                    if (nLen > 0) {
-                        if (m_nSize > 0) {
-                            wchar_t* pTemp = m_pData;
-
-                            m_nSize += nLen;
-                            m_pData = static_cast<wchar_t*>(PlanetKitMemory::AllocateArrayMemory((m_nSize + 1) * sizeof(wchar_t)));
-                            wcscpy_s(m_pData, m_nSize + 1, pTemp);
-                            wcscat_s(m_pData, m_nSize + 1, rhs);
-
-                            PlanetKitMemory::FreeArrayMemory(pTemp);
-                        }
-                        else {
-                            Copy(rhs);
-                        }
-                    }
+            void AppendData(const wchar_t* rhs, size_t nLen) {
+                if (nLen == 0) {
+                    return;
+                }
+
+                size_t nNewSize = m_nSize + nLen;
+
+                // rhs may point into this string, so it is copied before the old buffer is released.
+                wchar_t* pBuffer = static_cast<wchar_t*>(PlanetKitMemory::AllocateArrayMemory((nNewSize + 1) * sizeof(wchar_t)));
+                if (m_nSize > 0) {
+                    wmemcpy(pBuffer, m_pData, m_nSize);
                 }
+                wmemcpy(pBuffer + m_nSize, rhs, nLen);
+                pBuffer[nNewSize] = L'\0';
+
+                ReleaseBuffer();
+                m_pData = pBuffer;
+                m_nSize = nNewSize;
             }
 
-            void Clear() {
+            /**
+             * Take over the buffer of src. src is left without a buffer until it is assigned again.
+             */
+            void MoveFrom(WString& src) {
+                m_pData = src.m_pData;
+                m_nSize = src.m_nSize;
+
+                src.m_pData = nullptr;
+                src.m_nSize = 0;
+            }
+
+            void ReleaseBuffer() {
                 if (m_pData) {
                     PlanetKitMemory::FreeArrayMemory(m_pData);
-                    m_pData = nullptr;
-                    m_nSize = 0;
                 }
             }
 
@@ -490,8 +573,16 @@ namespace PlanetKit {
     private:
         wchar_t* m_pData = nullptr;
         size_t m_nSize = 0;
+
+        // Grows the buffer geometrically and keeps track of its capacity itself.
+        friend class WStringBuilder;
     };
+
+    // WString is exchanged with the SDK binary, also as WStringArray elements, so its layout must stay the same.
+    static_assert(sizeof(WString) == sizeof(void*) + sizeof(wchar_t*) + sizeof(size_t), "WString must keep the layout of the SDK binary");
 };
 
 
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
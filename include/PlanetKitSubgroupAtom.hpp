@@ -0,0 +1,273 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+#include "PlanetKit.h"
+#include "PlanetKitCommonTypes.h"
+#include "PlanetKitHash.hpp"
+
+namespace PlanetKit {
+    /**
+     * Interned subgroup name.
+     * @remark
+     *   Every distinct subgroup name is stored once in a process-wide table. Two atoms are equal if and only if they refer
+     *   to the same entry, so comparison and hashing cost a pointer compare and a load of a precomputed hash.<br>
+     *   A default-constructed atom represents the main room, which is NullOptional (PlanetKitMainRoomName) in the APIs taking a subgroup name.
+     *   An empty name is a name like any other and does not give the main room.<br>
+     *   Include this header where atoms are used. It pulls in <mutex>, so PlanetKitSubgroupDefine.h does not include it.<br>
+     *   Atoms can be created, copied and released on any thread. An entry is removed from the table when its last atom is released.
+     */
+    class SubgroupAtom {
+    public:
+        /**
+         * Creates the main room atom.
+         */
+        SubgroupAtom() : m_pEntry(nullptr) {}
+
+        SubgroupAtom(const SubgroupAtom& src) : m_pEntry(src.m_pEntry) {
+            if (m_pEntry) {
+                m_pEntry->refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        SubgroupAtom(SubgroupAtom&& src) : m_pEntry(src.m_pEntry) {
+            src.m_pEntry = nullptr;
+        }
+
+        ~SubgroupAtom() {
+            Release();
+        }
+
+        SubgroupAtom& operator=(const SubgroupAtom& src) {
+            if (m_pEntry != src.m_pEntry) {
+                Release();
+                m_pEntry = src.m_pEntry;
+                if (m_pEntry) {
+                    m_pEntry->refCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return *this;
+        }
+
+        SubgroupAtom& operator=(SubgroupAtom&& src) {
+            if (this != &src) {
+                Release();
+                m_pEntry = src.m_pEntry;
+                src.m_pEntry = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Gets the atom of a subgroup name.
+         * @param strSubgroupName Subgroup name. NullOptional gives the main room atom.
+         * @return Atom shared by every caller that interns the same name.
+         */
+        static SubgroupAtom Intern(const WStringOptional& strSubgroupName) {
+            if (strSubgroupName.HasValue() == false) {
+                return SubgroupAtom();
+            }
+            return Intern(strSubgroupName->c_str(), strSubgroupName->Size());
+        }
+
+        /**
+         * Gets the atom of a subgroup name.
+         * @param strSubgroupName Subgroup name.
+         */
+        static SubgroupAtom Intern(const WString& strSubgroupName) {
+            return Intern(strSubgroupName.c_str(), strSubgroupName.Size());
+        }
+
+        /**
+         * Gets the atom of a subgroup name.
+         * @param szSubgroupName Null-terminated subgroup name. nullptr gives the main room atom, like PlanetKitMainRoomName.
+         */
+        static SubgroupAtom Intern(const wchar_t* szSubgroupName) {
+            if (szSubgroupName == nullptr) {
+                return SubgroupAtom();
+            }
+            return Intern(szSubgroupName, wcslen(szSubgroupName));
+        }
+
+        /**
+         * Checks whether this atom represents the main room.
+         */
+        bool IsMainRoom() const {
+            return m_pEntry == nullptr;
+        }
+
+        /**
+         * Gets the subgroup name in the form taken by the subgroup name parameters of the PlanetKit APIs.
+         * @return NullOptional for the main room. The reference stays valid as long as this atom is alive.
+         */
+        const WStringOptional& GetName() const {
+            if (m_pEntry == nullptr) {
+                return MainRoomName();
+            }
+            return m_pEntry->strName;
+        }
+
+        /**
+         * Gets the precomputed hash of the subgroup name.
+         */
+        uint64_t GetHash() const {
+            return m_pEntry ? m_pEntry->ullHash : 0;
+        }
+
+        /**
+         * Lets an atom be passed directly wherever a subgroup name is taken as const WStringOptional&,
+         * for example PlanetKitConference::RequestPeerVideo or PeerControl::StartVideo, without copying the name.
+         */
+        operator const WStringOptional&() const {
+            return GetName();
+        }
+
+        bool operator==(const SubgroupAtom& rhs) const {
+            return m_pEntry == rhs.m_pEntry;
+        }
+
+        bool operator!=(const SubgroupAtom& rhs) const {
+            return m_pEntry != rhs.m_pEntry;
+        }
+
+    private:
+        struct Entry {
+            Entry(const wchar_t* szName, size_t nLen, uint64_t hash) : strName(WString()), ullHash(hash), refCount(1), pNext(nullptr) {
+                strName->Append(szName, nLen);
+            }
+
+            WStringOptional strName;
+            uint64_t ullHash;
+            std::atomic<long> refCount;
+            Entry* pNext;
+        };
+
+        class Table {
+        public:
+            Table() : m_ppBuckets(nullptr), m_nBucketCount(0), m_nCount(0) {
+                Rehash(64);
+            }
+
+            SubgroupAtom Acquire(const wchar_t* szName, size_t nLen, uint64_t ullHash) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                Entry** ppBucket = &m_ppBuckets[ullHash & (m_nBucketCount - 1)];
+                for (Entry* pEntry = *ppBucket; pEntry != nullptr; pEntry = pEntry->pNext) {
+                    if (pEntry->ullHash == ullHash && pEntry->strName->Size() == nLen && wmemcmp(pEntry->strName->c_str(), szName, nLen) == 0) {
+                        pEntry->refCount.fetch_add(1, std::memory_order_relaxed);
+                        return SubgroupAtom(pEntry);
+                    }
+                }
+
+                Entry* pEntry = static_cast<Entry*>(PlanetKitMemory::AllocateMemory(sizeof(Entry)));
+                new (pEntry) Entry(szName, nLen, ullHash);
+                pEntry->pNext = *ppBucket;
+                *ppBucket = pEntry;
+
+                if (++m_nCount > m_nBucketCount) {
+                    Rehash(m_nBucketCount * 2);
+                }
+
+                return SubgroupAtom(pEntry);
+            }
+
+            void Release(Entry* pEntry) {
+                // Counts above one are dropped without the lock. The transitions between one and zero only happen
+                // under the lock, so a concurrent Acquire() can never resurrect an entry that is being freed.
+                long lCount = pEntry->refCount.load(std::memory_order_relaxed);
+                while (lCount > 1) {
+                    if (pEntry->refCount.compare_exchange_weak(lCount, lCount - 1, std::memory_order_release, std::memory_order_relaxed)) {
+                        return;
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (pEntry->refCount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    return;
+                }
+
+                Entry** ppLink = &m_ppBuckets[pEntry->ullHash & (m_nBucketCount - 1)];
+                while (*ppLink != pEntry) {
+                    ppLink = &(*ppLink)->pNext;
+                }
+                *ppLink = pEntry->pNext;
+                --m_nCount;
+
+                pEntry->~Entry();
+                PlanetKitMemory::FreeMemory(pEntry);
+            }
+
+        private:
+            void Rehash(size_t nBucketCount) {
+                Entry** ppBuckets = static_cast<Entry**>(PlanetKitMemory::AllocateArrayMemory(nBucketCount * sizeof(Entry*)));
+                for (size_t i = 0; i < nBucketCount; ++i) {
+                    ppBuckets[i] = nullptr;
+                }
+
+                for (size_t i = 0; i < m_nBucketCount; ++i) {
+                    Entry* pEntry = m_ppBuckets[i];
+                    while (pEntry != nullptr) {
+                        Entry* pNext = pEntry->pNext;
+                        Entry** ppBucket = &ppBuckets[pEntry->ullHash & (nBucketCount - 1)];
+                        pEntry->pNext = *ppBucket;
+                        *ppBucket = pEntry;
+                        pEntry = pNext;
+                    }
+                }
+
+                if (m_ppBuckets) {
+                    PlanetKitMemory::FreeArrayMemory(m_ppBuckets);
+                }
+                m_ppBuckets = ppBuckets;
+                m_nBucketCount = nBucketCount;
+            }
+
+            std::mutex m_mutex;
+            Entry** m_ppBuckets;
+            size_t m_nBucketCount;
+            size_t m_nCount;
+        };
+
+        explicit SubgroupAtom(Entry* pEntry) : m_pEntry(pEntry) {}
+
+        static SubgroupAtom Intern(const wchar_t* szName, size_t nLen) {
+            return GetTable().Acquire(szName, nLen, HashChars(szName, nLen));
+        }
+
+        static Table& GetTable() {
+            // Never destroyed, so atoms held by other static objects stay valid during process exit.
+            static Table* s_pTable = new (PlanetKitMemory::AllocateMemory(sizeof(Table))) Table();
+            return *s_pTable;
+        }
+
+        static const WStringOptional& MainRoomName() {
+            static const WStringOptional s_mainRoomName(NullOptional);
+            return s_mainRoomName;
+        }
+
+        void Release() {
+            if (m_pEntry) {
+                GetTable().Release(m_pEntry);
+                m_pEntry = nullptr;
+            }
+        }
+
+        Entry* m_pEntry;
+    };
+};
@@ -17,6 +17,7 @@
 #include "PlanetKit.h"
 #include "PlanetKitSharedPtr.hpp"
 #include "PlanetKitCommonTypes.h"
+#include "PlanetKitHash.hpp"
 
 
 namespace PlanetKit {
@@ -45,5 +46,46 @@ namespace PlanetKit {
         virtual const WString& GetServiceID() const = 0;
         /// Gets the user country code.
         virtual const WStringOptional& GetCountry() const = 0;
+
+        /**
+         * Gets a 64-bit fingerprint of the user ID and service ID.
+         * @remark
+         *   The value is computed on every call, because UserId instances are created by the SDK and have no room to cache it.
+         *   HashMap keeps the fingerprint of every stored key, so a lookup computes it only for the key being looked up.
+         */
+        uint64_t GetHash() const {
+            const WString& strID = GetID();
+            const WString& strServiceID = GetServiceID();
+
+            // The ID length is mixed in so that ("ab", "c") and ("a", "bc") hash differently.
+            return HashChars(strServiceID.c_str(), strServiceID.Size(), HashChars(strID.c_str(), strID.Size()) ^ HashMix(strID.Size()));
+        }
+
+        /**
+         * Checks whether rhs identifies the same user.
+         */
+        bool IsSameUser(const UserId& rhs) const {
+            if (this == &rhs) {
+                return true;
+            }
+            return GetID() == rhs.GetID() && GetServiceID() == rhs.GetServiceID();
+        }
+    };
+
+    /**
+     * Lets UserIdPtr be used as a HashMap key. Keys are matched by user ID and service ID, not by instance.
+     */
+    template <>
+    struct HashTraits<UserIdPtr, void> {
+        static uint64_t Hash(const UserIdPtr& value) {
+            return value.hasValue() ? value->GetHash() : 0;
+        }
+
+        static bool Equal(const UserIdPtr& lhs, const UserIdPtr& rhs) {
+            if (lhs.hasValue() == false || rhs.hasValue() == false) {
+                return lhs.hasValue() == rhs.hasValue();
+            }
+            return lhs->IsSameUser(*rhs);
+        }
     };
 }
\ No newline at end of file
@@ -92,8 +92,151 @@ namespace PlanetKit {
         wchar_t szSubgroupName[PLNK_BUFFER_SIZE_512];
     }SVideoFrame;
 
+    /**
+     * Plane of an I420 frame
+     */
+    typedef enum EI420Plane {
+        /// Luma
+        PLNK_I420_PLANE_Y = 0,
+        /// Blue-difference chroma
+        PLNK_I420_PLANE_U = 1,
+        /// Red-difference chroma
+        PLNK_I420_PLANE_V = 2
+    } EI420Plane;
+
+    /**
+     * Memory layout of an I420 frame: a Y plane followed by quarter-size U and V planes in one buffer.
+     * @remark
+     *   All values are exact integers and every method is constexpr, so layouts for fixed resolutions are computed at compile time.<br>
+     *   For odd widths and heights the chroma planes round up, so the last column and row of luma samples still have chroma.<br>
+     *   A stride is the distance in bytes between the starts of two rows of a plane and can be larger than the plane's width.
+     */
+    class I420Layout {
+    public:
+        /**
+         * Tightly packed layout. Strides equal the plane widths.
+         */
+        constexpr I420Layout(unsigned int unWidth, unsigned int unHeight)
+            : m_unWidth(unWidth), m_unHeight(unHeight), m_unYStride(unWidth), m_unUVStride(HalfUp(unWidth)) {
+        }
+
+        /**
+         * Layout with a luma stride such as VideoFrame::GetStride. Chroma planes use half of it, rounded up.
+         */
+        constexpr I420Layout(unsigned int unWidth, unsigned int unHeight, unsigned int unYStride)
+            : m_unWidth(unWidth), m_unHeight(unHeight), m_unYStride(unYStride), m_unUVStride(HalfUp(unYStride)) {
+        }
+
+        /**
+         * Layout with explicit luma and chroma strides.
+         */
+        constexpr I420Layout(unsigned int unWidth, unsigned int unHeight, unsigned int unYStride, unsigned int unUVStride)
+            : m_unWidth(unWidth), m_unHeight(unHeight), m_unYStride(unYStride), m_unUVStride(unUVStride) {
+        }
+
+        /**
+         * Layout whose strides are the plane widths rounded up to a multiple of unAlignment.
+         * @param unAlignment Row alignment in bytes. Must be a power of two, for example 16 or 32 for SIMD access.
+         * @remark If the buffer itself is aligned the same way, every row of every plane starts aligned.
+         */
+        static constexpr I420Layout Aligned(unsigned int unWidth, unsigned int unHeight, unsigned int unAlignment) {
+            return I420Layout(unWidth, unHeight, AlignUp(unWidth, unAlignment), AlignUp(HalfUp(unWidth), unAlignment));
+        }
+
+        constexpr unsigned int GetWidth() const {
+            return m_unWidth;
+        }
+
+        constexpr unsigned int GetHeight() const {
+            return m_unHeight;
+        }
+
+        /**
+         * Gets the width of the U and V planes.
+         */
+        constexpr unsigned int GetChromaWidth() const {
+            return HalfUp(m_unWidth);
+        }
+
+        /**
+         * Gets the height of the U and V planes.
+         */
+        constexpr unsigned int GetChromaHeight() const {
+            return HalfUp(m_unHeight);
+        }
+
+        /**
+         * Gets the stride of a plane in bytes.
+         */
+        constexpr unsigned int GetStride(EI420Plane ePlane) const {
+            return ePlane == PLNK_I420_PLANE_Y ? m_unYStride : m_unUVStride;
+        }
+
+        /**
+         * Gets the width of a plane in bytes.
+         */
+        constexpr unsigned int GetPlaneWidth(EI420Plane ePlane) const {
+            return ePlane == PLNK_I420_PLANE_Y ? m_unWidth : GetChromaWidth();
+        }
+
+        /**
+         * Gets the number of rows of a plane.
+         */
+        constexpr unsigned int GetPlaneHeight(EI420Plane ePlane) const {
+            return ePlane == PLNK_I420_PLANE_Y ? m_unHeight : GetChromaHeight();
+        }
+
+        /**
+         * Gets the size of a plane in bytes, including row padding.
+         */
+        constexpr size_t GetPlaneSize(EI420Plane ePlane) const {
+            return (size_t)GetStride(ePlane) * GetPlaneHeight(ePlane);
+        }
+
+        /**
+         * Gets the offset of a plane from the start of the buffer in bytes.
+         */
+        constexpr size_t GetPlaneOffset(EI420Plane ePlane) const {
+            return ePlane == PLNK_I420_PLANE_Y ? 0
+                : ePlane == PLNK_I420_PLANE_U ? GetPlaneSize(PLNK_I420_PLANE_Y)
+                : GetPlaneSize(PLNK_I420_PLANE_Y) + GetPlaneSize(PLNK_I420_PLANE_U);
+        }
+
+        /**
+         * Gets the size of the whole frame in bytes.
+         */
+        constexpr size_t GetSize() const {
+            return GetPlaneSize(PLNK_I420_PLANE_Y) + 2 * GetPlaneSize(PLNK_I420_PLANE_U);
+        }
+
+        /**
+         * Checks that every stride is at least as large as its plane's width.
+         */
+        constexpr bool IsValid() const {
+            return m_unYStride >= m_unWidth && m_unUVStride >= GetChromaWidth();
+        }
+
+    private:
+        static constexpr unsigned int HalfUp(unsigned int unValue) {
+            return unValue / 2 + (unValue & 1);
+        }
+
+        static constexpr unsigned int AlignUp(unsigned int unValue, unsigned int unAlignment) {
+            return (unValue + unAlignment - 1) & ~(unAlignment - 1);
+        }
+
+        unsigned int m_unWidth;
+        unsigned int m_unHeight;
+        unsigned int m_unYStride;
+        unsigned int m_unUVStride;
+    };
+
+    /**
+     * Gets the size of a tightly packed I420 frame in bytes.
+     * @remark Chroma planes round up for odd dimensions. Use I420Layout for strided frames.
+     */
     template<typename T>
-    inline T GET_VIDEO_DATA_LENGTH(const T& witdh, const T& height) {
-        return (T)(witdh * height * 1.5);
+    inline constexpr T GET_VIDEO_DATA_LENGTH(const T& witdh, const T& height) {
+        return (T)I420Layout((unsigned int)witdh, (unsigned int)height).GetSize();
     }
 };
\ No newline at end of file
@@ -0,0 +1,114 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <wchar.h>
+
+#include "PlanetKitVideoDefine.h"
+#include "PlanetKitSubgroupAtom.hpp"
+
+namespace PlanetKit {
+    /**
+     * Compact video frame information
+     * @remark
+     *   Carries the same information as SVideoFrame, but refers to the subgroup by a SubgroupAtom instead of embedding a
+     *   512 character name, so the descriptor fits in one 64-byte cache line on 64-bit builds instead of taking over 1 KB.
+     *   Pixel data is referenced by pbuffer as in SVideoFrame.<br>
+     *   Copying the descriptor adds a reference to the subgroup atom, so pass it by reference on per-frame paths.<br>
+     *   It lives in its own header rather than PlanetKitVideoDefine.h because SubgroupAtom brings in <mutex>.
+     */
+    typedef struct SVideoFrameDesc {
+        /// Pointer to the frame buffer
+        unsigned char* pbuffer;
+        /// Allocated buffer size
+        unsigned int unBufferSize;
+        /// Length (in bytes) of buffer
+        unsigned int unDataLength;
+        /// Width
+        unsigned int unWidth;
+        /// Height
+        unsigned int unHeight;
+        /// Tick
+        long long llTick;
+        /// Time stamp
+        long long llTimeStamp;
+        /// Duration
+        long long llDuration;
+        /// Rotation
+        EVideoRotation eRotation;
+        /// Subgroup the frame belongs to. SubgroupAtom::IsMainRoom() replaces SVideoFrame::bSubgroupMain.
+        SubgroupAtom atomSubgroup;
+
+        /**
+         * Converts a legacy frame description.
+         * @param sFrame Legacy frame description.
+         * @param atomHint Atom of the subgroup of a previous frame of the same stream, if any.
+         *   If its name matches, it is reused and the subgroup name does not have to be looked up in the intern table.
+         */
+        static SVideoFrameDesc FromLegacy(const SVideoFrame& sFrame, const SubgroupAtom& atomHint = SubgroupAtom()) {
+            SVideoFrameDesc sDesc;
+            sDesc.pbuffer = sFrame.pbuffer;
+            sDesc.unBufferSize = sFrame.unBufferSize;
+            sDesc.unDataLength = sFrame.unDataLength;
+            sDesc.unWidth = sFrame.unWidth;
+            sDesc.unHeight = sFrame.unHeight;
+            sDesc.llTick = sFrame.llTick;
+            sDesc.llTimeStamp = sFrame.llTimeStamp;
+            sDesc.llDuration = sFrame.llDuration;
+            sDesc.eRotation = sFrame.eRotation;
+
+            if (sFrame.bSubgroupMain == false) {
+                if (atomHint.IsMainRoom() == false && wcscmp(atomHint.GetName()->c_str(), sFrame.szSubgroupName) == 0) {
+                    sDesc.atomSubgroup = atomHint;
+                }
+                else {
+                    sDesc.atomSubgroup = SubgroupAtom::Intern(sFrame.szSubgroupName);
+                }
+            }
+
+            return sDesc;
+        }
+
+        /**
+         * Fills a legacy frame description.
+         * @remark Subgroup names longer than PLNK_BUFFER_SIZE_512 - 1 characters are truncated.
+         */
+        void ToLegacy(SVideoFrame& sFrame) const {
+            sFrame.pbuffer = pbuffer;
+            sFrame.unBufferSize = unBufferSize;
+            sFrame.unDataLength = unDataLength;
+            sFrame.unWidth = unWidth;
+            sFrame.unHeight = unHeight;
+            sFrame.llTick = llTick;
+            sFrame.llTimeStamp = llTimeStamp;
+            sFrame.llDuration = llDuration;
+            sFrame.eRotation = eRotation;
+            sFrame.bSubgroupMain = atomSubgroup.IsMainRoom();
+
+            size_t nLen = 0;
+            if (sFrame.bSubgroupMain == false) {
+                const WString& strName = *atomSubgroup.GetName();
+                nLen = strName.Size() < PLNK_BUFFER_SIZE_512 - 1 ? strName.Size() : PLNK_BUFFER_SIZE_512 - 1;
+                wmemcpy(sFrame.szSubgroupName, strName.c_str(), nLen);
+            }
+            sFrame.szSubgroupName[nLen] = 0;
+        }
+    } SVideoFrameDesc;
+
+#if defined(_WIN64) || defined(__x86_64__) || defined(__aarch64__) || defined(_M_ARM64)
+    static_assert(sizeof(SVideoFrameDesc) <= 64, "SVideoFrameDesc must fit in a cache line");
+#endif
+};
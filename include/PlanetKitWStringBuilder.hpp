@@ -0,0 +1,348 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdio.h>
+#include <wchar.h>
+
+#include "PlanetKitString.hpp"
+
+/// Size of the local buffer used to format numbers and decode narrow strings before they are appended.
+#define PLNK_WSTRING_BUILDER_CHUNK_LENGTH       64
+
+namespace PlanetKit {
+    /**
+     * Builds a WString from pieces.
+     * @remark
+     *   Numbers and narrow strings are formatted straight into the destination buffer, which grows geometrically.<br>
+     *   Call Reserve() up front when the final length is known to build the string with a single allocation.<br>
+     *   WString itself has no room to record a capacity, so the builder keeps track of it.
+     */
+    class PLANETKIT_API WStringBuilder {
+    public:
+        WStringBuilder() = default;
+
+        /**
+         * Create with an initial capacity
+         */
+        explicit WStringBuilder(size_t nCapacity) {
+            Reserve(nCapacity);
+        }
+
+        /**
+         * Allocate room for at least nCapacity characters
+         */
+        WStringBuilder& Reserve(size_t nCapacity) {
+            if (m_str.m_pData == nullptr || nCapacity > m_nCapacity) {
+                Grow(nCapacity, nullptr, 0);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Append wide string
+         */
+        WStringBuilder& Append(const wchar_t* rhs) {
+            if (rhs != nullptr) {
+                Write(rhs, wcslen(rhs));
+            }
+
+            return *this;
+        }
+
+        /**
+         * Append nLen characters of a wide string
+         */
+        WStringBuilder& Append(const wchar_t* rhs, size_t nLen) {
+            Write(rhs, nLen);
+
+            return *this;
+        }
+
+        /**
+         * Append wide string
+         */
+        WStringBuilder& Append(const WString& rhs) {
+            Write(rhs.c_str(), rhs.Size());
+
+            return *this;
+        }
+
+        /**
+         * Append a single character
+         */
+        WStringBuilder& Append(wchar_t ch) {
+            Write(&ch, 1);
+
+            return *this;
+        }
+
+        /**
+         * Append narrow string
+         * @param rhs UTF-8 encoded string. Invalid sequences are replaced with U+FFFD.
+         */
+        WStringBuilder& Append(const char* rhs) {
+            if (rhs != nullptr) {
+                AppendUtf8(rhs, strlen(rhs));
+            }
+
+            return *this;
+        }
+
+        /**
+         * Append narrow string
+         * @param rhs UTF-8 encoded string. Invalid sequences are replaced with U+FFFD.
+         */
+        WStringBuilder& Append(const String& rhs) {
+            AppendUtf8(rhs.c_str(), rhs.Size());
+
+            return *this;
+        }
+
+        WStringBuilder& Append(int nValue) {
+            return AppendSigned(nValue);
+        }
+
+        WStringBuilder& Append(long lValue) {
+            return AppendSigned(lValue);
+        }
+
+        WStringBuilder& Append(long long llValue) {
+            return AppendSigned(llValue);
+        }
+
+        WStringBuilder& Append(unsigned int unValue) {
+            return AppendUnsigned(unValue, false);
+        }
+
+        WStringBuilder& Append(unsigned long ulValue) {
+            return AppendUnsigned(ulValue, false);
+        }
+
+        WStringBuilder& Append(unsigned long long ullValue) {
+            return AppendUnsigned(ullValue, false);
+        }
+
+        /**
+         * Append floating point number
+         * @param dValue Value
+         * @param nPrecision Number of digits after the decimal point
+         */
+        WStringBuilder& Append(double dValue, int nPrecision = 6) {
+            wchar_t szBuffer[PLNK_WSTRING_BUILDER_CHUNK_LENGTH];
+            int nLen = swprintf(szBuffer, PLNK_WSTRING_BUILDER_CHUNK_LENGTH, L"%.*f", nPrecision, dValue);
+            if (nLen < 0) {
+                // Does not fit in the local buffer, so fall back to the exponent form which always fits.
+                nLen = swprintf(szBuffer, PLNK_WSTRING_BUILDER_CHUNK_LENGTH, L"%.*e", nPrecision > 16 ? 16 : nPrecision, dValue);
+            }
+
+            if (nLen > 0) {
+                Write(szBuffer, (size_t)nLen);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Append number
+         */
+        template <typename T>
+        WStringBuilder& operator<<(const T& value) {
+            return Append(value);
+        }
+
+        /**
+         * Get the number of characters built so far
+         */
+        size_t Size() const {
+            return m_str.Size();
+        }
+
+        /**
+         * Get string value
+         */
+        const wchar_t* c_str() const {
+            return m_str.c_str();
+        }
+
+        /**
+         * Get built string
+         */
+        const WString& GetString() const {
+            return m_str;
+        }
+
+        /**
+         * Move the built string out of the builder. The builder becomes empty.
+         */
+        WString TakeString() {
+            m_nCapacity = 0;
+            return std::move(m_str);
+        }
+
+        /**
+         * Clear the built string. The allocated capacity is kept.
+         */
+        void Clear() {
+            if (m_str.m_pData == nullptr) {
+                m_nCapacity = 0;
+            }
+            m_str.Empty();
+        }
+
+    private:
+        template <typename T>
+        WStringBuilder& AppendSigned(T value) {
+            if (value < 0) {
+                // Negate in the unsigned domain so that the minimum value does not overflow.
+                return AppendUnsigned(0ULL - (unsigned long long)value, true);
+            }
+
+            return AppendUnsigned((unsigned long long)value, false);
+        }
+
+        WStringBuilder& AppendUnsigned(unsigned long long ullValue, bool bNegative) {
+            wchar_t szBuffer[PLNK_WSTRING_BUILDER_CHUNK_LENGTH];
+            wchar_t* pEnd = szBuffer + PLNK_WSTRING_BUILDER_CHUNK_LENGTH;
+            wchar_t* pPos = pEnd;
+
+            do {
+                *--pPos = (wchar_t)(L'0' + (ullValue % 10));
+                ullValue /= 10;
+            } while (ullValue != 0);
+
+            if (bNegative) {
+                *--pPos = L'-';
+            }
+
+            Write(pPos, (size_t)(pEnd - pPos));
+
+            return *this;
+        }
+
+        void AppendCodePoint(wchar_t* pBuffer, size_t& nPos, unsigned int unCodePoint) {
+            if (sizeof(wchar_t) == 2 && unCodePoint >= 0x10000) {
+                unCodePoint -= 0x10000;
+                pBuffer[nPos++] = (wchar_t)(0xD800 + (unCodePoint >> 10));
+                pBuffer[nPos++] = (wchar_t)(0xDC00 + (unCodePoint & 0x3FF));
+            }
+            else {
+                pBuffer[nPos++] = (wchar_t)unCodePoint;
+            }
+        }
+
+        void AppendUtf8(const char* pSrc, size_t nLen) {
+            // A UTF-8 sequence never produces more UTF-16 or UTF-32 units than it has bytes.
+            size_t nStart = m_str.Size();
+            Reserve(nStart + nLen);
+
+            wchar_t szBuffer[PLNK_WSTRING_BUILDER_CHUNK_LENGTH];
+            size_t nPos = 0;
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(pSrc);
+            const unsigned char* pEnd = p + nLen;
+
+            while (p < pEnd) {
+                unsigned int unCodePoint = 0xFFFD;
+                unsigned char c = *p++;
+                int nTrail = 0;
+                unsigned int unMin = 0;
+
+                if (c < 0x80) {
+                    unCodePoint = c;
+                }
+                else if ((c & 0xE0) == 0xC0) {
+                    unCodePoint = c & 0x1F;
+                    nTrail = 1;
+                    unMin = 0x80;
+                }
+                else if ((c & 0xF0) == 0xE0) {
+                    unCodePoint = c & 0x0F;
+                    nTrail = 2;
+                    unMin = 0x800;
+                }
+                else if ((c & 0xF8) == 0xF0) {
+                    unCodePoint = c & 0x07;
+                    nTrail = 3;
+                    unMin = 0x10000;
+                }
+
+                for (int i = 0; i < nTrail; ++i) {
+                    if (p >= pEnd || (*p & 0xC0) != 0x80) {
+                        unCodePoint = 0xFFFD;
+                        nTrail = 0;
+                        break;
+                    }
+                    unCodePoint = (unCodePoint << 6) | (*p++ & 0x3F);
+                }
+
+                if (nTrail > 0 && (unCodePoint < unMin || unCodePoint > 0x10FFFF || (unCodePoint >= 0xD800 && unCodePoint <= 0xDFFF))) {
+                    unCodePoint = 0xFFFD;
+                }
+
+                AppendCodePoint(szBuffer, nPos, unCodePoint);
+
+                if (nPos + 2 > PLNK_WSTRING_BUILDER_CHUNK_LENGTH) {
+                    Write(szBuffer, nPos);
+                    nPos = 0;
+                }
+            }
+
+            if (nPos > 0) {
+                Write(szBuffer, nPos);
+            }
+        }
+
+        /**
+         * Append nLen characters, doubling the capacity when they do not fit.
+         */
+        void Write(const wchar_t* rhs, size_t nLen) {
+            size_t nNewSize = m_str.m_nSize + nLen;
+            if (m_str.m_pData == nullptr || nNewSize > m_nCapacity) {
+                size_t nNewCapacity = m_nCapacity * 2;
+                Grow(nNewCapacity < nNewSize ? nNewSize : nNewCapacity, rhs, nLen);
+                return;
+            }
+
+            wmemmove(m_str.m_pData + m_str.m_nSize, rhs, nLen);
+            m_str.m_pData[nNewSize] = L'\0';
+            m_str.m_nSize = nNewSize;
+        }
+
+        /**
+         * Move the string into a buffer of nCapacity characters and append nLen characters of rhs.
+         * @remark rhs may point into the current buffer, which is released only after it has been copied.
+         */
+        void Grow(size_t nCapacity, const wchar_t* rhs, size_t nLen) {
+            size_t nSize = m_str.m_nSize;
+            wchar_t* pBuffer = static_cast<wchar_t*>(PlanetKitMemory::AllocateArrayMemory((nCapacity + 1) * sizeof(wchar_t)));
+            if (nSize > 0) {
+                wmemcpy(pBuffer, m_str.m_pData, nSize);
+            }
+            if (nLen > 0) {
+                wmemcpy(pBuffer + nSize, rhs, nLen);
+            }
+            pBuffer[nSize + nLen] = L'\0';
+
+            m_str.ReleaseBuffer();
+            m_str.m_pData = pBuffer;
+            m_str.m_nSize = nSize + nLen;
+            m_nCapacity = nCapacity;
+        }
+
+        WString m_str;
+        size_t m_nCapacity = 0;
+    };
+};
@@ -0,0 +1,131 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "PlanetKitSharedPtr.hpp"
+
+namespace PlanetKit {
+    /**
+     * Non-owning reference to an object managed by InplaceSharedPtr.
+     * @remark
+     *   A WeakPtr does not keep the object alive. Use it to break reference cycles, for example
+     *   when an event handler registered to a conference needs to refer back to the conference owner.<br>
+     *   Call lock() to get an InplaceSharedPtr to the object, which is empty if the object has already been released.<br>
+     *   Only InplaceSharedPtr control blocks carry a weak count. SharedPtr blocks are also created by the SDK binary
+     *   without one, so SharedPtr has no weak companion.
+     */
+    template <typename T, typename RefCountPolicy = AtomicRefCountPolicy>
+    class WeakPtr {
+    public:
+        WeakPtr() : ptr_(nullptr), control_block_(nullptr) {}
+        WeakPtr(std::nullptr_t) : ptr_(nullptr), control_block_(nullptr) {}
+
+        WeakPtr(const WeakPtr& other) {
+            copy(other.ptr_, other.control_block_);
+        }
+
+        WeakPtr(WeakPtr&& other) : ptr_(other.ptr_), control_block_(other.control_block_) {
+            other.ptr_ = nullptr;
+            other.control_block_ = nullptr;
+        }
+
+        template <typename U>
+        WeakPtr(const WeakPtr<U, RefCountPolicy>& other) {
+            copy(other.ptr_, other.control_block_);
+        }
+
+        template <typename U>
+        WeakPtr(const InplaceSharedPtr<U, RefCountPolicy>& other) {
+            copy(other.ptr_, other.control_block_);
+        }
+
+        ~WeakPtr() {
+            release();
+        }
+
+        WeakPtr& operator=(const WeakPtr& other) {
+            if (this != &other) {
+                release();
+                copy(other.ptr_, other.control_block_);
+            }
+            return *this;
+        }
+
+        WeakPtr& operator=(WeakPtr&& other) {
+            if (this != &other) {
+                release();
+                ptr_ = other.ptr_;
+                control_block_ = other.control_block_;
+                other.ptr_ = nullptr;
+                other.control_block_ = nullptr;
+            }
+            return *this;
+        }
+
+        template <typename U>
+        WeakPtr& operator=(const InplaceSharedPtr<U, RefCountPolicy>& other) {
+            release();
+            copy(other.ptr_, other.control_block_);
+            return *this;
+        }
+
+        WeakPtr& operator=(std::nullptr_t) {
+            release();
+            return *this;
+        }
+
+        /**
+         * Gets an InplaceSharedPtr to the object.
+         * @return InplaceSharedPtr to the object, or an empty one if the object has already been released.
+         * @remark This method does not take a lock and can be called from any thread unless RefCountPolicy is SingleThreadRefCountPolicy.
+         */
+        InplaceSharedPtr<T, RefCountPolicy> lock() const {
+            if (control_block_ && control_block_->addRefIfAlive()) {
+                return InplaceSharedPtr<T, RefCountPolicy>(ptr_, control_block_);
+            }
+            return InplaceSharedPtr<T, RefCountPolicy>();
+        }
+
+        /**
+         * Checks whether the object has already been released.
+         */
+        bool expired() const {
+            return control_block_ == nullptr || control_block_->isAlive() == false;
+        }
+
+    private:
+        void copy(T* ptr, InplaceControlBlockBase<RefCountPolicy>* pControlBlock) {
+            ptr_ = ptr;
+            control_block_ = pControlBlock;
+            if (control_block_) {
+                control_block_->addWeakRef();
+            }
+        }
+
+        void release() {
+            if (control_block_) {
+                control_block_->releaseWeakRef();
+                control_block_ = nullptr;
+            }
+            ptr_ = nullptr;
+        }
+
+        T* ptr_;
+        InplaceControlBlockBase<RefCountPolicy>* control_block_;
+
+        template <typename U, typename P>
+        friend class WeakPtr;
+    };
+};
@@ -0,0 +1,188 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+#include <new>
+#include <string.h>
+
+#include "PlanetKit.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    // Members of Array as the SDK binary sees them.
+    template <typename T>
+    struct BaselineArrayLayout {
+        void* pVtable;
+        T* m_pData;
+        size_t m_nSize;
+    };
+
+    // What the SDK binary's Resize does: Clear(), then exactly size default-constructed elements.
+    template <typename T>
+    void ResizeAsSdk(Array<T>& arr, size_t size) {
+        BaselineArrayLayout<T>* pLayout = reinterpret_cast<BaselineArrayLayout<T>*>(&arr);
+        for (size_t i = 0; i < pLayout->m_nSize; ++i) {
+            pLayout->m_pData[i].~T();
+        }
+        if (pLayout->m_pData) {
+            PlanetKitMemory::FreeArrayMemory(pLayout->m_pData);
+        }
+        pLayout->m_pData = nullptr;
+        pLayout->m_nSize = 0;
+
+        pLayout->m_pData = static_cast<T*>(PlanetKitMemory::AllocateArrayMemory(size * sizeof(T)));
+        for (size_t i = 0; i < size; ++i) {
+            new (&pLayout->m_pData[i]) T();
+        }
+        pLayout->m_nSize = size;
+    }
+
+    void TestGrowAfterSdkRefillAtSameAddress() {
+        Array<int> arrValues;
+        PLNK_CHECK(arrValues.Resize(1000));
+
+        // The SDK frees the buffer and allocates the same size again, which the allocator usually serves from the same
+        // address. The array must not mistake that for a buffer with room to grow into.
+        ResizeAsSdk(arrValues, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            arrValues[i] = i;
+        }
+
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        PLNK_CHECK(arrValues.Resize(5000));
+        PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() == ullAllocations + 1);
+        PLNK_CHECK(arrValues.Size() == 5000);
+        PLNK_CHECK(arrValues[999] == 999 && arrValues[1000] == 0 && arrValues[4999] == 0);
+    }
+
+    void TestBuiltArrayFilledBySdk() {
+        ArrayBuilder<WString> builder;
+        PLNK_CHECK(builder.Reserve(64));
+        PLNK_CHECK(builder.PushBack(WString(L"first")));
+        PLNK_CHECK(builder.Capacity() >= 64);
+
+        Array<WString> arrNames = builder.TakeArray();
+        PLNK_CHECK(builder.Size() == 0 && builder.Capacity() == 0);
+        PLNK_CHECK(arrNames.Size() == 1 && arrNames[0] == L"first");
+
+        ResizeAsSdk(arrNames, 3);
+        PLNK_CHECK(arrNames.Size() == 3);
+
+        PLNK_CHECK(arrNames.Resize(100));
+        for (size_t i = 3; i < arrNames.Size(); ++i) {
+            arrNames[i] = L"appended";
+        }
+        PLNK_CHECK(arrNames[2].Size() == 0);
+        PLNK_CHECK(arrNames[99] == L"appended");
+    }
+
+    void TestAppendOwnElement() {
+        ArrayBuilder<WString> builder;
+        PLNK_CHECK(builder.PushBack(WString(L"subgroup-name-that-is-not-short")));
+        for (int i = 0; i < 40; ++i) {
+            size_t nCapacity = builder.Capacity();
+            PLNK_CHECK(builder.PushBack(builder[0]));
+            if (i % 2 == 0) {
+                PLNK_CHECK(builder.EmplaceBack(builder[builder.Size() - 1]));
+            }
+            PLNK_CHECK(builder.Capacity() >= nCapacity);
+        }
+
+        for (size_t i = 0; i < builder.Size(); ++i) {
+            PLNK_CHECK(builder[i] == L"subgroup-name-that-is-not-short");
+        }
+    }
+
+    void TestBuilderBookkeeping() {
+        ArrayBuilder<int> builder;
+        for (int i = 0; i < 10; ++i) {
+            PLNK_CHECK(builder.PushBack(i));
+        }
+        size_t nCapacity = builder.Capacity();
+        PLNK_CHECK(nCapacity >= 10);
+
+        builder.PopBack();
+        PLNK_CHECK(builder.Size() == 9 && builder.Capacity() == nCapacity);
+
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        builder.Clear();
+        for (int i = 0; i < (int)nCapacity; ++i) {
+            PLNK_CHECK(builder.PushBack(i));
+        }
+        PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() == ullAllocations);
+        PLNK_CHECK(builder.View().Size() == nCapacity && builder.View()[nCapacity - 1] == (int)nCapacity - 1);
+    }
+
+    void TestResizeAndAssign() {
+        Array<int> arrValues;
+        PLNK_CHECK(arrValues.Resize(10));
+        for (int i = 0; i < 10; ++i) {
+            arrValues[i] = i;
+        }
+
+        arrValues.Erase(0);
+        arrValues.PopBack();
+        PLNK_CHECK(arrValues.Resize(4));
+        PLNK_CHECK(arrValues.Size() == 4);
+        PLNK_CHECK(arrValues[0] == 1 && arrValues[3] == 4);
+
+        Array<int> arrMoved(std::move(arrValues));
+        PLNK_CHECK(arrMoved.Size() == 4 && arrMoved[3] == 4);
+        PLNK_CHECK(arrValues.Size() == 0 && arrValues.Buffer() == nullptr);
+
+        const int values[] = { 7, 8 };
+        int* pBuffer = arrMoved.Buffer();
+        PLNK_CHECK(arrMoved.Assign(values, 2));
+        PLNK_CHECK(arrMoved.Size() == 2 && arrMoved.Buffer() == pBuffer);
+        PLNK_CHECK(arrMoved[1] == 8);
+    }
+
+    void TestAllocationFailure() {
+        ArrayBuilder<uint64_t> builder;
+        PLNK_CHECK(builder.Reserve(SIZE_MAX / 4) == false);
+        PLNK_CHECK(builder.Capacity() == 0);
+
+        Array<uint64_t> arrValues;
+        PLNK_CHECK(arrValues.Resize(2));
+        arrValues[1] = 7;
+        PLNK_CHECK(arrValues.Resize(SIZE_MAX / 2) == false);
+        PLNK_CHECK(arrValues.Size() == 2 && arrValues[1] == 7);
+
+        // volatile keeps the compiler from warning about the copy that the failed allocation skips.
+        volatile size_t nTooMany = SIZE_MAX / 4;
+        PLNK_CHECK(arrValues.ResizeUninitialized(nTooMany) == false);
+        PLNK_CHECK(arrValues.Assign(nullptr, nTooMany) == false);
+        PLNK_CHECK(arrValues.Size() == 2 && arrValues[1] == 7);
+
+        Array<unsigned char> arrBytes;
+        const unsigned char bytes[] = { 1, 2, 3 };
+        PLNK_CHECK(arrBytes.ResizeUninitialized(3));
+        memcpy(arrBytes.Buffer(), bytes, 3);
+        PLNK_CHECK(arrBytes.Assign(bytes, 2) && arrBytes.Size() == 2 && arrBytes[1] == 2);
+    }
+};
+
+int main() {
+    TestGrowAfterSdkRefillAtSameAddress();
+    TestBuiltArrayFilledBySdk();
+    TestAppendOwnElement();
+    TestBuilderBookkeeping();
+    TestResizeAndAssign();
+    TestAllocationFailure();
+    return PlanetKitTest::Finish("ArrayTest");
+}
@@ -0,0 +1,196 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Checks that AudioFramePool stops allocating once it holds the peak number of frames in use, and releases everything.
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+#include "PlanetKitAudioFramePool.hpp"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    uint64_t Allocations() {
+        return PlanetKitHostMemory::GetAllocationCount();
+    }
+
+    void TestSteadyStateDoesNotAllocate() {
+        AudioFramePool pool;
+
+        // Warm-up: the peak is three frames in flight.
+        {
+            AudioFramePtr frames[3];
+            for (int i = 0; i < 3; ++i) {
+                frames[i] = pool.Acquire(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16);
+                PLNK_CHECK(frames[i]);
+            }
+        }
+
+        uint64_t ullAllocations = Allocations();
+        for (int nRound = 0; nRound < 1000; ++nRound) {
+            AudioFramePtr frames[3];
+            for (int i = 0; i < 3; ++i) {
+                frames[i] = pool.Acquire(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16);
+            }
+            AudioFramePtr copy = frames[0];
+            PLNK_CHECK(copy.get() == frames[0].get());
+        }
+        PLNK_CHECK(Allocations() == ullAllocations);
+
+        SAudioFramePoolStatistics sStatistics = pool.GetStatistics();
+        PLNK_CHECK(sStatistics.ullAllocated == 3);
+        PLNK_CHECK(sStatistics.ullAcquired == 3003);
+        PLNK_CHECK(sStatistics.ullOutstanding == 0);
+        PLNK_CHECK(sStatistics.ullFailed == 0);
+    }
+
+    void TestReserve() {
+        AudioFramePool pool;
+        uint64_t ullAllocations = Allocations();
+        PLNK_CHECK(pool.Reserve(16000, 160, PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32, 4));
+        PLNK_CHECK(Allocations() - ullAllocations == 4);
+
+        // Reserving again does not add frames that are already free.
+        PLNK_CHECK(pool.Reserve(16000, 160, PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32, 4));
+        PLNK_CHECK(Allocations() - ullAllocations == 4);
+
+        ullAllocations = Allocations();
+        AudioFramePtr frames[4];
+        for (int i = 0; i < 4; ++i) {
+            frames[i] = pool.Acquire(16000, 160, PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32);
+            PLNK_CHECK(frames[i]);
+        }
+        PLNK_CHECK(Allocations() == ullAllocations);
+    }
+
+    void TestAlignmentAndShape() {
+        SAudioFramePoolConfig sConfig;
+        sConfig.unAlignment = 256;
+        AudioFramePool pool(sConfig);
+
+        AudioFramePtr frame = pool.Acquire(48000, 960, PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32);
+        PLNK_CHECK(frame);
+        PLNK_CHECK(((uintptr_t)frame->GetAudioData().ucBuffer & 255) == 0);
+        PLNK_CHECK(frame->GetCapacity() == 960 * sizeof(float));
+        PLNK_CHECK(frame->GetAudioData().unBufferSize == 960 * sizeof(float));
+
+        // Fields changed while the frame is held are restored when it comes back.
+        AudioFrame* pFrame = frame.get();
+        frame->GetAudioData().unBufferSize = 4;
+        frame->GetAudioData().unAudioDataSampleCount = 1;
+        frame.reset();
+
+        frame = pool.Acquire(48000, 960, PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32);
+        PLNK_CHECK(frame.get() == pFrame);
+        PLNK_CHECK(frame->GetAudioData().unBufferSize == 960 * sizeof(float));
+        PLNK_CHECK(frame->GetAudioData().unAudioDataSampleCount == 960);
+    }
+
+    void TestAcquireCopy() {
+        AudioFramePool pool;
+        int16_t samples[160];
+        for (int i = 0; i < 160; ++i) {
+            samples[i] = (int16_t)(i * 7);
+        }
+
+        SAudioData src = {};
+        src.unAudioDataSamplingRate = 16000;
+        src.unAudioDataSampleCount = 160;
+        src.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+        src.ucBuffer = reinterpret_cast<unsigned char*>(samples);
+        src.unBufferSize = sizeof(samples);
+
+        AudioFramePtr frame = pool.AcquireCopy(src);
+        PLNK_CHECK(frame);
+        PLNK_CHECK(frame->GetAudioData().unAudioDataSampleCount == 160);
+        PLNK_CHECK(memcmp(frame->GetAudioData().ucBuffer, samples, sizeof(samples)) == 0);
+    }
+
+    void TestShapeLimit() {
+        AudioFramePool pool;
+        for (unsigned int i = 0; i < PLNK_AUDIO_FRAME_POOL_MAX_SHAPES; ++i) {
+            PLNK_CHECK(pool.Acquire(48000, 10 + i, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16));
+        }
+
+        uint64_t ullAllocations = Allocations();
+        PLNK_CHECK(!pool.Acquire(48000, 1000, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16));
+        PLNK_CHECK(!pool.Acquire(0, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16));
+        PLNK_CHECK(Allocations() == ullAllocations);
+        PLNK_CHECK(pool.GetStatistics().ullFailed == 2);
+    }
+
+    void TestReleaseOnAnotherThread() {
+        AudioFramePool pool;
+        AudioFramePtr frame = pool.Acquire(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16);
+        AudioFrame* pFrame = frame.get();
+
+        std::thread worker([&frame]() {
+            AudioFramePtr held(std::move(frame));
+        });
+        worker.join();
+        PLNK_CHECK(pool.GetStatistics().ullOutstanding == 0);
+
+        uint64_t ullAllocations = Allocations();
+        frame = pool.Acquire(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16);
+        PLNK_CHECK(frame.get() == pFrame);
+        PLNK_CHECK(Allocations() == ullAllocations);
+    }
+
+    void TestReserveWhileFramesCycle() {
+        // Workers recycling frames must not make Reserve believe frames are free that were never allocated.
+        for (int nRound = 0; nRound < 200; ++nRound) {
+            AudioFramePool pool;
+            std::atomic<bool> bStop{ false };
+            std::thread workers[2];
+            for (std::thread& worker : workers) {
+                worker = std::thread([&pool, &bStop]() {
+                    while (!bStop.load(std::memory_order_relaxed)) {
+                        AudioFramePtr frame = pool.Acquire(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16);
+                    }
+                });
+            }
+
+            PLNK_CHECK(pool.Reserve(48000, 480, PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16, 32));
+            bStop.store(true, std::memory_order_relaxed);
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            PLNK_CHECK(pool.GetStatistics().ullAllocated >= 32);
+        }
+    }
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+    TestSteadyStateDoesNotAllocate();
+    TestReserve();
+    TestAlignmentAndShape();
+    TestAcquireCopy();
+    TestShapeLimit();
+    TestReleaseOnAnotherThread();
+    TestReserveWhileFramesCycle();
+
+    // Destroying a pool returns every frame it allocated.
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == PlanetKitHostMemory::GetFreeCount() - ullFrees);
+
+    return PlanetKitTest::Finish("AudioFramePoolTest");
+}
@@ -0,0 +1,190 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Checks AudioResampler output frame counts, streaming continuity, reported latency against the measured group delay,
+// and an approximated ratio that uses the extra filter phase.
+
+#include <math.h>
+#include <string.h>
+
+#include "PlanetKitAudioResampler.hpp"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    const double kPi = 3.14159265358979323846;
+
+    SAudioResamplerConfig MakeConfig(unsigned int unInputRate, unsigned int unOutputRate, unsigned int unChannels = 1) {
+        SAudioResamplerConfig sConfig;
+        sConfig.unInputSamplingRate = unInputRate;
+        sConfig.unOutputSamplingRate = unOutputRate;
+        sConfig.unChannels = unChannels;
+        return sConfig;
+    }
+
+    void FillTone(float* pSamples, size_t nFrames, unsigned int unChannels, unsigned int unRate, double dToneHz) {
+        for (size_t i = 0; i < nFrames; ++i) {
+            for (unsigned int c = 0; c < unChannels; ++c) {
+                pSamples[i * unChannels + c] = (float)(0.5 * sin(2 * kPi * dToneHz * i / unRate + c));
+            }
+        }
+    }
+
+    void TestFrameCounts() {
+        const unsigned int rates[][2] = { { 44100, 48000 }, { 48000, 16000 }, { 16000, 48000 } };
+        for (const unsigned int* pRates : rates) {
+            AudioResampler resampler(MakeConfig(pRates[0], pRates[1]));
+
+            // 10 ms in gives exactly 10 ms out, every call.
+            size_t nInputFrames = pRates[0] / 100;
+            size_t nExpected = pRates[1] / 100;
+            PLNK_CHECK(resampler.GetMaxOutputFrames(nInputFrames) == nExpected);
+
+            float input[480] = {};
+            float output[480];
+            bool bExact = true;
+            for (int i = 0; i < 100; ++i) {
+                size_t nOutputFrames = 0;
+                PLNK_CHECK(resampler.Process(input, nInputFrames, output, 480, nOutputFrames));
+                bExact = bExact && nOutputFrames == nExpected;
+            }
+            PLNK_CHECK(bExact);
+
+            size_t nOutputFrames = 1;
+            PLNK_CHECK(resampler.Process(input, nInputFrames, output, nExpected - 1, nOutputFrames) == false);
+            PLNK_CHECK(nOutputFrames == 0);
+        }
+    }
+
+    void TestChunkedMatchesWhole() {
+        const unsigned int rates[][2] = { { 44100, 48000 }, { 48000, 16000 }, { 16000, 48000 }, { 48000, 47999 } };
+        for (const unsigned int* pRates : rates) {
+            const unsigned int unChannels = 2;
+            size_t nInputFrames = pRates[0];
+            size_t nChunk = pRates[0] / 100;
+
+            float* pInput = new float[nInputFrames * unChannels];
+            FillTone(pInput, nInputFrames, unChannels, pRates[0], 997.0);
+
+            AudioResampler whole(MakeConfig(pRates[0], pRates[1], unChannels));
+            size_t nCapacity = whole.GetMaxOutputFrames(nInputFrames);
+            float* pWhole = new float[nCapacity * unChannels];
+            size_t nWholeFrames = 0;
+            PLNK_CHECK(whole.Process(pInput, nInputFrames, pWhole, nCapacity, nWholeFrames));
+
+            AudioResampler chunked(MakeConfig(pRates[0], pRates[1], unChannels));
+            float* pChunked = new float[(nCapacity + 100) * unChannels];
+            size_t nChunkedFrames = 0;
+            for (size_t nOffset = 0; nOffset < nInputFrames; nOffset += nChunk) {
+                size_t nOutputFrames = 0;
+                PLNK_CHECK(chunked.Process(pInput + nOffset * unChannels, nChunk, pChunked + nChunkedFrames * unChannels, nCapacity + 100 - nChunkedFrames, nOutputFrames));
+                nChunkedFrames += nOutputFrames;
+            }
+
+            PLNK_CHECK(nChunkedFrames == nWholeFrames);
+            PLNK_CHECK(memcmp(pChunked, pWhole, nWholeFrames * unChannels * sizeof(float)) == 0);
+
+            delete[] pChunked;
+            delete[] pWhole;
+            delete[] pInput;
+        }
+    }
+
+    void TestLatencyMatchesGroupDelay() {
+        const unsigned int rates[][2] = { { 44100, 48000 }, { 48000, 16000 }, { 16000, 48000 } };
+        for (const unsigned int* pRates : rates) {
+            AudioResampler resampler(MakeConfig(pRates[0], pRates[1]));
+
+            // An impulse at input frame 100. The filter is linear phase, so the centroid of the response is its delay.
+            const size_t nInputFrames = 2048;
+            float input[nInputFrames] = {};
+            input[100] = 1.0f;
+            float output[3 * nInputFrames];
+            size_t nOutputFrames = 0;
+            PLNK_CHECK(resampler.Process(input, nInputFrames, output, 3 * nInputFrames, nOutputFrames));
+
+            double dWeighted = 0;
+            double dSum = 0;
+            for (size_t i = 0; i < nOutputFrames; ++i) {
+                dWeighted += (double)i * output[i];
+                dSum += output[i];
+            }
+            double dDelayInputFrames = dWeighted / dSum * pRates[0] / pRates[1] - 100;
+
+            PLNK_CHECK(fabs(dDelayInputFrames - resampler.GetLatencyInputFrames()) < 0.05);
+            PLNK_CHECK(fabs(resampler.GetLatencyMicroseconds() - resampler.GetLatencyInputFrames() * 1e6 / pRates[0]) <= 0.5);
+        }
+    }
+
+    void TestApproximatedRatio() {
+        // 48000 -> 47999 reduces to 47999 phases. The nearest of PLNK_AUDIO_RESAMPLER_MAX_PHASES is used, and rounding up
+        // past the last one selects the extra phase.
+        AudioResampler resampler(MakeConfig(48000, 47999));
+
+        size_t nInputFrames = 48000;
+        float* pInput = new float[nInputFrames];
+        size_t nCapacity = resampler.GetMaxOutputFrames(nInputFrames);
+        float* pOutput = new float[nCapacity];
+
+        // Every phase, the extra one included, passes DC at unity gain.
+        for (size_t i = 0; i < nInputFrames; ++i) {
+            pInput[i] = 0.25f;
+        }
+        size_t nOutputFrames = 0;
+        PLNK_CHECK(resampler.Process(pInput, nInputFrames, pOutput, nCapacity, nOutputFrames));
+        PLNK_CHECK(nOutputFrames == 47999);
+
+        double dWorst = 0;
+        for (size_t i = 1000; i < nOutputFrames; ++i) {
+            double dError = fabs(pOutput[i] - 0.25);
+            dWorst = dError > dWorst ? dError : dWorst;
+        }
+        PLNK_CHECK(dWorst < 1e-5);
+
+        // A 1 kHz tone comes out as a 1 kHz tone at the output rate, delayed by the reported latency.
+        resampler.Reset();
+        FillTone(pInput, nInputFrames, 1, 48000, 1000.0);
+        PLNK_CHECK(resampler.Process(pInput, nInputFrames, pOutput, nCapacity, nOutputFrames));
+
+        double dLatencySeconds = resampler.GetLatencyInputFrames() / 48000.0;
+        double dError = 0;
+        double dSignal = 0;
+        for (size_t i = 1000; i < nOutputFrames; ++i) {
+            double dExpected = 0.5 * sin(2 * kPi * 1000.0 * ((double)i / 47999.0 - dLatencySeconds));
+            dError += (pOutput[i] - dExpected) * (pOutput[i] - dExpected);
+            dSignal += dExpected * dExpected;
+        }
+        PLNK_CHECK(10 * log10(dError / dSignal) < -60);
+
+        delete[] pOutput;
+        delete[] pInput;
+    }
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+    TestFrameCounts();
+    TestChunkedMatchesWhole();
+    TestLatencyMatchesGroupDelay();
+    TestApproximatedRatio();
+
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == PlanetKitHostMemory::GetFreeCount() - ullFrees);
+
+    return PlanetKitTest::Finish("AudioResamplerTest");
+}
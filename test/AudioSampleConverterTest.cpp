@@ -0,0 +1,309 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Runs every AudioSampleConverter kernel at every SIMD level this processor supports and compares it with the scalar
+// reference, over all lengths up to a few vectors so that every tail is covered, and with full-scale, infinite and NaN input.
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits>
+
+#include "PlanetKitAudioSampleConverter.hpp"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    const size_t kMaxCount = 70;
+
+    const EAudioSimdLevel levels[] = {
+        PLNK_AUDIO_SIMD_LEVEL_SSE2,
+        PLNK_AUDIO_SIMD_LEVEL_AVX2,
+        PLNK_AUDIO_SIMD_LEVEL_NEON,
+    };
+
+    /**
+     * Float input with the edge cases spread over the positions a vector kernel and its scalar tail handle.
+     */
+    void MakeFloatInput(float* pSamples, size_t nCount) {
+        const float special[] = {
+            0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 32767.0f / 32768.0f, -32767.0f / 32768.0f,
+            0.5f / 32768.0f, 1.5f / 32768.0f, -2.5f / 32768.0f, 2.0f, -2.0f, 1e30f, -1e30f,
+            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+        };
+        const size_t nSpecial = sizeof(special) / sizeof(special[0]);
+
+        uint32_t unState = 12345;
+        for (size_t i = 0; i < nCount; ++i) {
+            if (i % 3 == 0) {
+                pSamples[i] = special[(i / 3) % nSpecial];
+            }
+            else {
+                unState = unState * 1664525u + 1013904223u;
+                pSamples[i] = (float)((int32_t)unState) / 1431655765.0f;
+            }
+        }
+    }
+
+    void TestFloatToInt16() {
+        float input[kMaxCount + 1];
+        MakeFloatInput(input, kMaxCount + 1);
+
+        AudioSampleConverter::SetSimdLevel(PLNK_AUDIO_SIMD_LEVEL_SCALAR);
+        int16_t reference[kMaxCount + 1];
+        AudioSampleConverter::FloatToInt16(input, reference, kMaxCount + 1);
+
+        float edges[] = { 1.0f, -1.0f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), 0.5f / 32768.0f, 1.5f / 32768.0f };
+        int16_t edgeOutput[7];
+        AudioSampleConverter::FloatToInt16(edges, edgeOutput, 7);
+        PLNK_CHECK(edgeOutput[0] == 32767 && edgeOutput[1] == -32768);
+        PLNK_CHECK(edgeOutput[2] == 32767 && edgeOutput[3] == -32768);
+        PLNK_CHECK(edgeOutput[4] == 32767);
+        PLNK_CHECK(edgeOutput[5] == 0 && edgeOutput[6] == 2);
+
+        for (EAudioSimdLevel eLevel : levels) {
+            if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+                continue;
+            }
+
+            // Every length, from an unaligned start as well.
+            for (size_t nOffset = 0; nOffset <= 1; ++nOffset) {
+                for (size_t nCount = 0; nCount + nOffset <= kMaxCount + 1; ++nCount) {
+                    int16_t output[kMaxCount + 2];
+                    output[nCount] = 0x5A5A;
+                    AudioSampleConverter::FloatToInt16(input + nOffset, output, nCount);
+                    PLNK_CHECK(memcmp(output, reference + nOffset, nCount * sizeof(int16_t)) == 0);
+                    PLNK_CHECK(output[nCount] == 0x5A5A);
+                }
+            }
+        }
+    }
+
+    void TestInt16ToFloat() {
+        int16_t input[65536];
+        for (int i = 0; i < 65536; ++i) {
+            input[i] = (int16_t)(i - 32768);
+        }
+
+        static float reference[65536];
+        static float output[65536];
+        AudioSampleConverter::SetSimdLevel(PLNK_AUDIO_SIMD_LEVEL_SCALAR);
+        AudioSampleConverter::Int16ToFloat(input, reference, 65536);
+        PLNK_CHECK(reference[0] == -1.0f && reference[32768] == 0.0f && reference[65535] == 32767.0f / 32768.0f);
+
+        for (EAudioSimdLevel eLevel : levels) {
+            if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+                continue;
+            }
+
+            AudioSampleConverter::Int16ToFloat(input, output, 65536);
+            PLNK_CHECK(memcmp(output, reference, sizeof(reference)) == 0);
+
+            for (size_t nCount = 0; nCount <= kMaxCount; ++nCount) {
+                AudioSampleConverter::Int16ToFloat(input + 1, output, nCount);
+                PLNK_CHECK(memcmp(output, reference + 1, nCount * sizeof(float)) == 0);
+            }
+        }
+    }
+
+    void TestApplyGain() {
+        const float gains[] = { 0.5f, 3.0f, -1.0f, 0.0f };
+
+        float floatInput[kMaxCount];
+        MakeFloatInput(floatInput, kMaxCount);
+
+        int16_t shortInput[kMaxCount];
+        for (size_t i = 0; i < kMaxCount; ++i) {
+            shortInput[i] = (int16_t)(i % 4 == 0 ? -32768 : i % 4 == 1 ? 32767 : (int)(i * 997) - 30000);
+        }
+
+        for (float fGain : gains) {
+            AudioSampleConverter::SetSimdLevel(PLNK_AUDIO_SIMD_LEVEL_SCALAR);
+            float floatReference[kMaxCount];
+            memcpy(floatReference, floatInput, sizeof(floatInput));
+            AudioSampleConverter::ApplyGain(floatReference, kMaxCount, fGain);
+
+            int16_t shortReference[kMaxCount];
+            memcpy(shortReference, shortInput, sizeof(shortInput));
+            AudioSampleConverter::ApplyGain(shortReference, kMaxCount, fGain);
+            if (fGain == -1.0f) {
+                PLNK_CHECK(shortReference[0] == 32767 && shortReference[1] == -32767);
+            }
+
+            for (EAudioSimdLevel eLevel : levels) {
+                if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+                    continue;
+                }
+
+                for (size_t nCount = 0; nCount <= kMaxCount; ++nCount) {
+                    float floatOutput[kMaxCount];
+                    memcpy(floatOutput, floatInput, sizeof(floatInput));
+                    AudioSampleConverter::ApplyGain(floatOutput, nCount, fGain);
+                    PLNK_CHECK(memcmp(floatOutput, floatReference, nCount * sizeof(float)) == 0);
+                    PLNK_CHECK(memcmp(floatOutput + nCount, floatInput + nCount, (kMaxCount - nCount) * sizeof(float)) == 0);
+
+                    int16_t shortOutput[kMaxCount];
+                    memcpy(shortOutput, shortInput, sizeof(shortInput));
+                    AudioSampleConverter::ApplyGain(shortOutput, nCount, fGain);
+                    PLNK_CHECK(memcmp(shortOutput, shortReference, nCount * sizeof(int16_t)) == 0);
+                    PLNK_CHECK(memcmp(shortOutput + nCount, shortInput + nCount, (kMaxCount - nCount) * sizeof(int16_t)) == 0);
+                }
+            }
+        }
+    }
+
+    void TestInterleave() {
+        float planar[3][kMaxCount];
+        for (unsigned int c = 0; c < 3; ++c) {
+            for (size_t i = 0; i < kMaxCount; ++i) {
+                planar[c][i] = (float)(c * 1000 + i);
+            }
+        }
+        const float* ppSrc[3] = { planar[0], planar[1], planar[2] };
+
+        const EAudioSimdLevel allLevels[] = { PLNK_AUDIO_SIMD_LEVEL_SCALAR, PLNK_AUDIO_SIMD_LEVEL_SSE2, PLNK_AUDIO_SIMD_LEVEL_AVX2, PLNK_AUDIO_SIMD_LEVEL_NEON };
+        for (EAudioSimdLevel eLevel : allLevels) {
+            if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+                continue;
+            }
+
+            for (unsigned int unChannels = 1; unChannels <= 3; ++unChannels) {
+                for (size_t nFrames = 0; nFrames <= kMaxCount; ++nFrames) {
+                    float interleaved[3 * kMaxCount + 1];
+                    interleaved[nFrames * unChannels] = -1.0f;
+                    AudioSampleConverter::Interleave(ppSrc, unChannels, nFrames, interleaved);
+
+                    bool bInterleaved = interleaved[nFrames * unChannels] == -1.0f;
+                    for (size_t i = 0; i < nFrames * unChannels; ++i) {
+                        bInterleaved = bInterleaved && interleaved[i] == planar[i % unChannels][i / unChannels];
+                    }
+                    PLNK_CHECK(bInterleaved);
+
+                    float split[3][kMaxCount + 1];
+                    float* ppDst[3] = { split[0], split[1], split[2] };
+                    for (unsigned int c = 0; c < unChannels; ++c) {
+                        split[c][nFrames] = -1.0f;
+                    }
+                    AudioSampleConverter::Deinterleave(interleaved, unChannels, nFrames, ppDst);
+
+                    bool bSplit = true;
+                    for (unsigned int c = 0; c < unChannels; ++c) {
+                        bSplit = bSplit && memcmp(split[c], planar[c], nFrames * sizeof(float)) == 0 && split[c][nFrames] == -1.0f;
+                    }
+                    PLNK_CHECK(bSplit);
+                }
+            }
+        }
+    }
+
+    void TestDither() {
+        const EAudioSimdLevel allLevels[] = { PLNK_AUDIO_SIMD_LEVEL_SCALAR, PLNK_AUDIO_SIMD_LEVEL_SSE2, PLNK_AUDIO_SIMD_LEVEL_AVX2, PLNK_AUDIO_SIMD_LEVEL_NEON };
+
+        float input[kMaxCount];
+        MakeFloatInput(input, kMaxCount);
+
+        const size_t nSilence = 48000;
+        static float silence[nSilence];
+        static int16_t noise[nSilence];
+
+        for (EAudioSimdLevel eLevel : allLevels) {
+            if (AudioSampleConverter::SetSimdLevel(eLevel) == false) {
+                continue;
+            }
+
+            // Dither moves a sample by at most one step from the undithered result, and never wraps at full scale.
+            int16_t undithered[kMaxCount];
+            AudioSampleConverter::FloatToInt16(input, undithered, kMaxCount);
+            SAudioDitherState sState;
+            for (size_t nCount = 0; nCount <= kMaxCount; ++nCount) {
+                int16_t output[kMaxCount];
+                AudioSampleConverter::FloatToInt16Dithered(input, output, nCount, sState);
+
+                bool bInRange = true;
+                for (size_t i = 0; i < nCount; ++i) {
+                    int nDifference = output[i] - undithered[i];
+                    bInRange = bInRange && nDifference >= -1 && nDifference <= 1;
+                    if (input[i] != input[i] || input[i] >= 1.0f) {
+                        bInRange = bInRange && output[i] >= 32766;
+                    }
+                    else if (input[i] <= -1.0f) {
+                        bInRange = bInRange && output[i] <= -32767;
+                    }
+                }
+                PLNK_CHECK(bInRange);
+            }
+
+            // Triangular noise in (-1, 1) rounds to 0 three quarters of the time and to +-1 one eighth each, with zero mean.
+            AudioSampleConverter::FloatToInt16Dithered(silence, noise, nSilence, sState);
+            size_t counts[3] = { 0, 0, 0 };
+            bool bBounded = true;
+            for (size_t i = 0; i < nSilence; ++i) {
+                bBounded = bBounded && noise[i] >= -1 && noise[i] <= 1;
+                if (noise[i] >= -1 && noise[i] <= 1) {
+                    ++counts[noise[i] + 1];
+                }
+            }
+            PLNK_CHECK(bBounded);
+            PLNK_CHECK(fabs(counts[1] / (double)nSilence - 0.75) < 0.02);
+            PLNK_CHECK(fabs(counts[0] / (double)nSilence - 0.125) < 0.01);
+            PLNK_CHECK(fabs(counts[2] / (double)nSilence - 0.125) < 0.01);
+        }
+    }
+
+    void TestConvert() {
+        float input[kMaxCount];
+        MakeFloatInput(input, kMaxCount);
+
+        AudioSampleConverter::SetSimdLevel(AudioSampleConverter::GetSupportedSimdLevel());
+        int16_t expected[kMaxCount];
+        AudioSampleConverter::FloatToInt16(input, expected, kMaxCount);
+
+        SAudioData src = {};
+        src.unAudioDataSamplingRate = 48000;
+        src.unAudioDataSampleCount = kMaxCount;
+        src.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_FLOAT_32;
+        src.ucBuffer = reinterpret_cast<unsigned char*>(input);
+        src.unBufferSize = sizeof(input);
+
+        int16_t output[kMaxCount];
+        SAudioData dst = {};
+        dst.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+        dst.ucBuffer = reinterpret_cast<unsigned char*>(output);
+        dst.unBufferSize = sizeof(output) - 1;
+        PLNK_CHECK(AudioSampleConverter::Convert(src, dst) == false);
+
+        dst.unBufferSize = sizeof(output);
+        PLNK_CHECK(AudioSampleConverter::Convert(src, dst));
+        PLNK_CHECK(dst.unBufferSize == sizeof(output) && dst.unAudioDataSampleCount == kMaxCount && dst.unAudioDataSamplingRate == 48000);
+        PLNK_CHECK(memcmp(output, expected, sizeof(output)) == 0);
+    }
+};
+
+int main() {
+    EAudioSimdLevel eSupported = AudioSampleConverter::GetSupportedSimdLevel();
+    PLNK_CHECK(AudioSampleConverter::SetSimdLevel(PLNK_AUDIO_SIMD_LEVEL_SCALAR));
+    PLNK_CHECK(AudioSampleConverter::SetSimdLevel(eSupported));
+
+    TestFloatToInt16();
+    TestInt16ToFloat();
+    TestApplyGain();
+    TestInterleave();
+    TestDither();
+    TestConvert();
+
+    AudioSampleConverter::SetSimdLevel(eSupported);
+    return PlanetKitTest::Finish("AudioSampleConverterTest");
+}
@@ -0,0 +1,257 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Checks the queueing, statistics and delivery cadence of BufferedCustomMic.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "PlanetKitBufferedCustomMic.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    enum {
+        FRAME_SAMPLES = 48,
+        FRAME_BYTES = FRAME_SAMPLES * 2,
+        MAX_CAPTURES = 64
+    };
+
+    std::atomic<uint64_t> g_ullCaptured(0);
+    unsigned char g_ucCapturedFirstBytes[MAX_CAPTURES];
+    std::chrono::steady_clock::time_point g_firstCapture;
+    std::chrono::steady_clock::time_point g_lastCapture;
+
+    class CountingMicEvent : public IMicEvent {
+    public:
+        bool DidCapture(const SAudioData& sAudioData) override {
+            uint64_t ullIndex = g_ullCaptured.load(std::memory_order_relaxed);
+            if (ullIndex < MAX_CAPTURES) {
+                g_ucCapturedFirstBytes[ullIndex] = sAudioData.ucBuffer[0];
+            }
+            g_lastCapture = std::chrono::steady_clock::now();
+            if (ullIndex == 0) {
+                g_firstCapture = g_lastCapture;
+            }
+            g_ullCaptured.store(ullIndex + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    class TestMic : public BufferedCustomMic {
+    public:
+        explicit TestMic(const SBufferedMicConfig& sConfig) : BufferedCustomMic(sConfig) {
+        }
+
+        bool SetVolumeLevel(float fVolume) override {
+            PLNK_UNREFERENCED_PARAMETER(fVolume);
+            return false;
+        }
+
+        float GetVolumeLevel() override {
+            return 0.0f;
+        }
+
+        float GetPeakValue() override {
+            return 0.0f;
+        }
+
+        bool IsRunning() override {
+            return true;
+        }
+
+        bool RegisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        bool DeregisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        AudioDeviceInfoPtr GetDeviceInfo() override {
+            return nullptr;
+        }
+    };
+
+    /**
+     * 1 ms of 48 kHz mono 16-bit audio whose first byte is ucMark.
+     */
+    SAudioData MakeFrame(unsigned char* pBuffer, unsigned char ucMark) {
+        pBuffer[0] = ucMark;
+        SAudioData sAudioData = {};
+        sAudioData.unAudioDataSamplingRate = 48000;
+        sAudioData.unAudioDataSampleCount = FRAME_SAMPLES;
+        sAudioData.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+        sAudioData.ucBuffer = pBuffer;
+        sAudioData.unBufferSize = FRAME_BYTES;
+        return sAudioData;
+    }
+
+    SBufferedMicConfig MakeConfig() {
+        SBufferedMicConfig sConfig;
+        sConfig.unDepth = 4;
+        sConfig.unPrefillFrames = 1;
+        sConfig.unMaxFrameBytes = FRAME_BYTES;
+        sConfig.unDefaultFrameMs = 1;
+        return sConfig;
+    }
+
+    bool WaitForCaptures(uint64_t ullCount) {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (g_ullCaptured.load(std::memory_order_acquire) < ullCount) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void TestOversizedFrameIsRejected() {
+        TestMic mic(MakeConfig());
+        unsigned char buffer[FRAME_BYTES + 1] = {};
+        SAudioData sAudioData = MakeFrame(buffer, 1);
+        sAudioData.unBufferSize = sizeof(buffer);
+
+        PLNK_CHECK(mic.EnqueueAudioData(sAudioData) == false);
+
+        SBufferedMicStatistics sStatistics = {};
+        mic.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullRejectedFrames == 1);
+        PLNK_CHECK(sStatistics.ullOverflowFrames == 0);
+        PLNK_CHECK(sStatistics.ullEnqueuedFrames == 0);
+        PLNK_CHECK(sStatistics.unFillLevel == 0);
+    }
+
+    void TestDropNewestOverflow() {
+        TestMic mic(MakeConfig());
+        unsigned char buffer[FRAME_BYTES] = {};
+        for (unsigned char i = 0; i < 4; ++i) {
+            PLNK_CHECK(mic.EnqueueAudioData(MakeFrame(buffer, i)));
+        }
+        PLNK_CHECK(mic.EnqueueAudioData(MakeFrame(buffer, 4)) == false);
+
+        SBufferedMicStatistics sStatistics = {};
+        mic.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullEnqueuedFrames == 4);
+        PLNK_CHECK(sStatistics.ullOverflowFrames == 1);
+        PLNK_CHECK(sStatistics.ullRejectedFrames == 0);
+        PLNK_CHECK(sStatistics.unFillLevel == 4);
+    }
+
+    void TestDeliveryKeepsOrderAndCadence() {
+        g_ullCaptured = 0;
+
+        TestMic mic(MakeConfig());
+        mic.RegisterMicEvent(MakeAutoPtr<CountingMicEvent>());
+
+        unsigned char buffer[FRAME_BYTES] = {};
+        for (unsigned char i = 0; i < 4; ++i) {
+            PLNK_CHECK(mic.EnqueueAudioData(MakeFrame(buffer, i)));
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        PLNK_CHECK(mic.Start());
+        PLNK_CHECK(mic.Start() == false);
+        PLNK_CHECK(WaitForCaptures(4));
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        mic.Stop();
+
+        // Frames are paced 1 ms apart, and sleeping never wakes up early.
+        PLNK_CHECK(elapsed >= std::chrono::milliseconds(3));
+
+        PLNK_CHECK(g_ullCaptured.load() == 4);
+        for (unsigned char i = 0; i < 4; ++i) {
+            PLNK_CHECK(g_ucCapturedFirstBytes[i] == i);
+        }
+
+        SBufferedMicStatistics sStatistics = {};
+        mic.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullDeliveredFrames == 4);
+        PLNK_CHECK(sStatistics.unFillLevel == 0);
+    }
+
+    void TestCadenceCountsSamples() {
+        g_ullCaptured = 0;
+
+        // 10 samples at 44.1 kHz last 226.76 us. Rounding each period down to whole microseconds would deliver the last of
+        // 3000 frames 2.3 ms early.
+        const unsigned int unFrames = 3000;
+        SBufferedMicConfig sConfig = MakeConfig();
+        sConfig.unDepth = unFrames + 1;
+        TestMic mic(sConfig);
+        mic.RegisterMicEvent(MakeAutoPtr<CountingMicEvent>());
+
+        unsigned char buffer[FRAME_BYTES] = {};
+        SAudioData sAudioData = MakeFrame(buffer, 0);
+        sAudioData.unAudioDataSamplingRate = 44100;
+        sAudioData.unAudioDataSampleCount = 10;
+        sAudioData.unBufferSize = 20;
+        for (unsigned int i = 0; i <= unFrames; ++i) {
+            PLNK_CHECK(mic.EnqueueAudioData(sAudioData));
+        }
+
+        PLNK_CHECK(mic.Start());
+        PLNK_CHECK(WaitForCaptures(unFrames + 1));
+        mic.Stop();
+
+        // The first capture may wake up late and the last one never wakes up early, so allow 1 ms of wake-up latency.
+        std::chrono::steady_clock::duration elapsed = g_lastCapture - g_firstCapture;
+        PLNK_CHECK(elapsed >= std::chrono::nanoseconds((uint64_t)unFrames * 10 * 1000000000ULL / 44100) - std::chrono::milliseconds(1));
+    }
+
+    void TestSilenceOnUnderflow() {
+        g_ullCaptured = 0;
+
+        SBufferedMicConfig sConfig = MakeConfig();
+        sConfig.unPrefillFrames = 0;
+        sConfig.eUnderflowPolicy = PLNK_BUFFERED_MIC_UNDERFLOW_SILENCE;
+        TestMic mic(sConfig);
+        mic.RegisterMicEvent(MakeAutoPtr<CountingMicEvent>());
+
+        unsigned char buffer[FRAME_BYTES] = {};
+        PLNK_CHECK(mic.EnqueueAudioData(MakeFrame(buffer, 0xAB)));
+        PLNK_CHECK(mic.Start());
+        PLNK_CHECK(WaitForCaptures(3));
+        mic.Stop();
+
+        SBufferedMicStatistics sStatistics = {};
+        mic.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullDeliveredFrames == 1);
+        PLNK_CHECK(sStatistics.ullUnderflows >= 2);
+        PLNK_CHECK(g_ucCapturedFirstBytes[0] == 0xAB);
+        PLNK_CHECK(g_ucCapturedFirstBytes[1] == 0);
+    }
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+    TestOversizedFrameIsRejected();
+    TestDropNewestOverflow();
+    TestDeliveryKeepsOrderAndCadence();
+    TestCadenceCountsSamples();
+    TestSilenceOnUnderflow();
+
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == PlanetKitHostMemory::GetFreeCount() - ullFrees);
+
+    return PlanetKitTest::Finish("BufferedCustomMicTest");
+}
@@ -0,0 +1,137 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Runs 10M PutAudioData calls against concurrent re-registration of the mic event.
+// Build with -DPLANETKIT_SANITIZER=thread to run it under TSAN.
+
+#include <atomic>
+#include <thread>
+
+#include "PlanetKitCustomMic.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    enum {
+        PUTS = 10000000
+    };
+
+    std::atomic<int> g_nLiveEvents(0);
+    std::atomic<uint64_t> g_ullCaptured(0);
+
+    class CountingMicEvent : public IMicEvent {
+    public:
+        CountingMicEvent() {
+            ++g_nLiveEvents;
+        }
+
+        ~CountingMicEvent() {
+            --g_nLiveEvents;
+        }
+
+        bool DidCapture(const SAudioData& sAudioData) override {
+            PLNK_UNREFERENCED_PARAMETER(sAudioData);
+            g_ullCaptured.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    class TestMic : public CustomMic {
+    public:
+        bool SetVolumeLevel(float fVolume) override {
+            PLNK_UNREFERENCED_PARAMETER(fVolume);
+            return false;
+        }
+
+        float GetVolumeLevel() override {
+            return 0.0f;
+        }
+
+        float GetPeakValue() override {
+            return 0.0f;
+        }
+
+        bool IsRunning() override {
+            return true;
+        }
+
+        bool RegisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        bool DeregisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        AudioDeviceInfoPtr GetDeviceInfo() override {
+            return nullptr;
+        }
+
+        // Subclasses written against the SharedPtr member keep compiling.
+        bool PutLegacy(SAudioData& audioData) {
+            if (m_pMicEvent.hasValue() == false || m_pMicEvent == nullptr) {
+                return false;
+            }
+
+            MicEventPtr pEvent = m_pMicEvent;
+            return pEvent.hasValue() && m_pMicEvent->DidCapture(audioData);
+        }
+    };
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+    {
+        TestMic mic;
+        unsigned char buffer[320] = {};
+        SAudioData sAudioData = {};
+        sAudioData.unAudioDataSamplingRate = 16000;
+        sAudioData.unAudioDataSampleCount = 160;
+        sAudioData.ucBuffer = buffer;
+        sAudioData.unBufferSize = sizeof(buffer);
+
+        std::atomic<bool> bDone(false);
+        std::thread registrar([&]() {
+            while (bDone.load(std::memory_order_relaxed) == false) {
+                MicEventPtr pEvent = MakeAutoPtr<CountingMicEvent>();
+                mic.RegisterMicEvent(pEvent);
+                std::this_thread::yield();
+                mic.DeregisterMicEvent(pEvent);
+            }
+        });
+
+        uint64_t ullDelivered = 0;
+        for (int i = 0; i < PUTS; ++i) {
+            if ((i & 1023) == 0 ? mic.PutLegacy(sAudioData) : mic.PutAudioData(sAudioData)) {
+                ++ullDelivered;
+            }
+        }
+        bDone = true;
+        registrar.join();
+
+        PLNK_CHECK(ullDelivered == g_ullCaptured.load());
+        printf("delivered %llu of %d puts\n", (unsigned long long)ullDelivered, (int)PUTS);
+    }
+
+    PLNK_CHECK(g_nLiveEvents.load() == 0);
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == PlanetKitHostMemory::GetFreeCount() - ullFrees);
+
+    return PlanetKitTest::Finish("CustomMicStressTest");
+}
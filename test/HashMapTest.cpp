@@ -0,0 +1,152 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include <type_traits>
+
+#include "PlanetKit.h"
+#include "PlanetKitUserId.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    class TestUserId : public UserId {
+    public:
+        TestUserId(const wchar_t* szID, const wchar_t* szServiceID) : m_strID(szID), m_strServiceID(szServiceID) {}
+
+        const WString& GetID() const override {
+            return m_strID;
+        }
+
+        const WString& GetServiceID() const override {
+            return m_strServiceID;
+        }
+
+        const WStringOptional& GetCountry() const override {
+            return m_strCountry;
+        }
+
+    private:
+        WString m_strID;
+        WString m_strServiceID;
+        WStringOptional m_strCountry;
+    };
+
+    static_assert(sizeof(TestUserId) == sizeof(void*) + 2 * sizeof(WString) + sizeof(WStringOptional), "UserId must not add data members");
+
+    void FillToThreshold(HashMap<int, int>& map) {
+        // Capacity 8 holds 6 entries before it grows.
+        for (int i = 0; i < 6; ++i) {
+            PLNK_CHECK(map.Insert(i, i * 10) != nullptr);
+        }
+    }
+
+    void TestLookupDoesNotRehash() {
+        HashMap<int, int> map;
+        FillToThreshold(map);
+
+        int* pValue = map.Find(3);
+        PLNK_CHECK(map.TryEmplace(3, 99) == pValue);
+        PLNK_CHECK(*pValue == 30);
+        PLNK_CHECK(map.Insert(3, 31) == pValue);
+        PLNK_CHECK(*pValue == 31);
+    }
+
+    void TestInsertAliasingValue() {
+        HashMap<int, WString> map;
+        for (int i = 0; i < 6; ++i) {
+            map.Insert(i, WString(L"a value long enough to live on the heap"));
+        }
+
+        // The value refers into the storage that this insertion reallocates.
+        const WString* pSource = map.Find(0);
+        WString* pInserted = map.Insert(100, *pSource);
+        PLNK_CHECK(pInserted != nullptr);
+        PLNK_CHECK(*pInserted == L"a value long enough to live on the heap");
+        PLNK_CHECK(map.Size() == 7);
+    }
+
+    void TestTryEmplace() {
+        HashMap<int, WString> map;
+        WString* pValue = map.TryEmplace(1);
+        PLNK_CHECK(pValue != nullptr && pValue->Size() == 0);
+        PLNK_CHECK(map.TryEmplace(2, L"emplaced") != nullptr && *map.Find(2) == L"emplaced");
+
+        for (int i = 3; i < 7; ++i) {
+            map.Insert(i, WString(L"a value long enough to live on the heap"));
+        }
+
+        // The argument refers into the storage that this insertion reallocates.
+        pValue = map.TryEmplace(7, *map.Find(6));
+        PLNK_CHECK(pValue != nullptr && *pValue == L"a value long enough to live on the heap");
+        PLNK_CHECK(map.Size() == 7);
+    }
+
+    void TestReserveOverflow() {
+        HashMap<int, int> map;
+        PLNK_CHECK(map.Reserve(SIZE_MAX / 4 * 3 + 1) == false);
+        PLNK_CHECK(map.Reserve(SIZE_MAX) == false);
+        PLNK_CHECK(map.Size() == 0);
+        PLNK_CHECK(map.Reserve(100));
+    }
+
+    void TestEraseAndIterate() {
+        HashMap<int, int> map;
+        for (int i = 0; i < 1000; ++i) {
+            map.Insert(i, i);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            PLNK_CHECK(map.Erase(i));
+        }
+        PLNK_CHECK(map.Size() == 500);
+
+        int nSum = 0;
+        for (auto entry : map) {
+            PLNK_CHECK(entry.key % 2 == 1);
+            entry.value += 1;
+        }
+
+        const HashMap<int, int>& constMap = map;
+        for (const auto& entry : constMap) {
+            PLNK_CHECK(entry.value == entry.key + 1);
+            nSum += entry.value;
+            static_assert(std::is_const<std::remove_reference<decltype(entry.value)>::type>::value, "values of a const map are const");
+            static_assert(std::is_const<std::remove_reference<decltype(entry.key)>::type>::value, "keys are const");
+        }
+        PLNK_CHECK(nSum == 500 * 501);
+    }
+
+    void TestUserIdKeys() {
+        HashMap<UserIdPtr, int> map;
+        map.Insert(MakeAutoPtr<TestUserId>(L"alice", L"svc"), 1);
+        map.Insert(MakeAutoPtr<TestUserId>(L"bob", L"svc"), 2);
+
+        // Keys match by value, not by instance.
+        const int* pValue = map.Find(MakeAutoPtr<TestUserId>(L"bob", L"svc"));
+        PLNK_CHECK(pValue != nullptr && *pValue == 2);
+        PLNK_CHECK(map.Contains(MakeAutoPtr<TestUserId>(L"bob", L"other")) == false);
+        PLNK_CHECK(MakeAutoPtr<TestUserId>(L"ab", L"c")->GetHash() != MakeAutoPtr<TestUserId>(L"a", L"bc")->GetHash());
+    }
+};
+
+int main() {
+    TestLookupDoesNotRehash();
+    TestInsertAliasingValue();
+    TestTryEmplace();
+    TestReserveOverflow();
+    TestEraseAndIterate();
+    TestUserIdKeys();
+    return PlanetKitTest::Finish("HashMapTest");
+}
@@ -0,0 +1,49 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include <string.h>
+
+#include "PlanetKitMemory.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    void TestAlignedMemory() {
+        const size_t alignments[] = { 1, 8, 16, 32, 64, 4096 };
+        for (size_t nAlignment : alignments) {
+            uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+            uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+            void* ptr = PlanetKitMemory::AllocateAlignedMemory(1000, nAlignment);
+            PLNK_CHECK(ptr != nullptr);
+            PLNK_CHECK(reinterpret_cast<uintptr_t>(ptr) % nAlignment == 0);
+            memset(ptr, 0x5A, 1000);
+            PlanetKitMemory::FreeAlignedMemory(ptr);
+
+            PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == 1);
+            PLNK_CHECK(PlanetKitHostMemory::GetFreeCount() - ullFrees == 1);
+        }
+
+        PlanetKitMemory::FreeAlignedMemory(nullptr);
+        PLNK_CHECK(PlanetKitMemory::AllocateAlignedMemory(SIZE_MAX - 8, 64) == nullptr);
+    }
+};
+
+int main() {
+    TestAlignedMemory();
+    return PlanetKitTest::Finish("MemoryTest");
+}
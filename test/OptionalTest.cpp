@@ -0,0 +1,82 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+#include "PlanetKitCommonTypes.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    // Layout of Optional in the SDK binary.
+    template <typename T>
+    struct BaselineOptional {
+        bool m_bHasValue;
+        T m_value;
+    };
+
+    void TestLayout() {
+        PLNK_CHECK(sizeof(Optional<int>) == sizeof(BaselineOptional<int>));
+        PLNK_CHECK(sizeof(Optional<WString>) == sizeof(BaselineOptional<WString>));
+
+        // The SDK reads the flag at offset 0 and the value right after it.
+        WStringOptional strName(WString(L"subgroup"));
+        PLNK_CHECK(*reinterpret_cast<const bool*>(&strName) == true);
+        BaselineOptional<int> baseline;
+        Optional<int> nValue(7);
+        PLNK_CHECK(reinterpret_cast<const char*>(&baseline.m_value) - reinterpret_cast<const char*>(&baseline) ==
+                   reinterpret_cast<const char*>(&*nValue) - reinterpret_cast<const char*>(&nValue));
+        PLNK_CHECK(*reinterpret_cast<const int*>(reinterpret_cast<const char*>(&nValue) + (reinterpret_cast<const char*>(&baseline.m_value) - reinterpret_cast<const char*>(&baseline))) == 7);
+
+        WStringOptional strEmpty(NullOptional);
+        PLNK_CHECK(*reinterpret_cast<const bool*>(&strEmpty) == false);
+    }
+
+    void TestValue() {
+        WStringOptional strName;
+        PLNK_CHECK(strName.HasValue() == false);
+
+        strName = WString(L"room");
+        PLNK_CHECK(strName.HasValue());
+        PLNK_CHECK(strName.Value() == L"room");
+
+        WStringOptional strMoved(std::move(strName));
+        PLNK_CHECK(strMoved.HasValue());
+        PLNK_CHECK(strMoved.Value() == L"room");
+
+        WStringOptional strCopy(strMoved);
+        PLNK_CHECK(strCopy.Value() == L"room");
+
+        strCopy.Emplace(L"other");
+        PLNK_CHECK(strCopy.HasValue());
+        PLNK_CHECK(strCopy.Value() == L"other");
+
+        strCopy = NullOptional;
+        PLNK_CHECK(strCopy.HasValue() == false);
+        PLNK_CHECK(strCopy->Size() == 0);
+
+        strCopy = strMoved;
+        PLNK_CHECK(strCopy.Value() == L"room");
+        strMoved.Reset();
+        strCopy = std::move(strMoved);
+        PLNK_CHECK(strCopy.HasValue() == false);
+    }
+};
+
+int main() {
+    TestLayout();
+    TestValue();
+    return PlanetKitTest::Finish("OptionalTest");
+}
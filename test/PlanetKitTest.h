@@ -0,0 +1,50 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include <stdio.h>
+
+namespace PlanetKitTest {
+    inline int& FailureCount() {
+        static int s_nFailures = 0;
+        return s_nFailures;
+    }
+
+    inline void Fail(const char* szExpression, const char* szFile, int nLine) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", szFile, nLine, szExpression);
+        ++FailureCount();
+    }
+
+    /**
+     * Prints the outcome and returns the process exit code.
+     */
+    inline int Finish(const char* szName) {
+        if (FailureCount() == 0) {
+            printf("%s: passed\n", szName);
+            return 0;
+        }
+
+        printf("%s: %d check(s) failed\n", szName, FailureCount());
+        return 1;
+    }
+};
+
+#define PLNK_CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            PlanetKitTest::Fail(#expression, __FILE__, __LINE__); \
+        } \
+    } while (0)
@@ -0,0 +1,97 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "PlanetKitPoolAllocator.hpp"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    void TestSizeClassesArePacked() {
+        PlanetKitPoolAllocator pool;
+
+        // The smallest class has no per-block overhead, so consecutive blocks are 16 bytes apart.
+        unsigned char* p1 = static_cast<unsigned char*>(pool.Allocate(16));
+        unsigned char* p2 = static_cast<unsigned char*>(pool.Allocate(16));
+        PLNK_CHECK(p1 != nullptr && p2 != nullptr);
+        PLNK_CHECK((p1 > p2 ? p1 - p2 : p2 - p1) == 16);
+
+        pool.Free(p1, 16);
+        pool.Free(p2, 16);
+    }
+
+    void TestAlignment() {
+        PlanetKitPoolAllocator pool;
+        const size_t sizes[] = { 1, 16, 17, 100, 1024, 1025, 100000 };
+        for (size_t nSize : sizes) {
+            void* ptr = pool.Allocate(nSize);
+            PLNK_CHECK(ptr != nullptr);
+            PLNK_CHECK(reinterpret_cast<uintptr_t>(ptr) % 16 == 0);
+            memset(ptr, 0xA5, nSize);
+            pool.Free(ptr, nSize);
+        }
+
+        void* pAligned = pool.Allocate(200, 64);
+        PLNK_CHECK(reinterpret_cast<uintptr_t>(pAligned) % 64 == 0);
+        pool.Free(pAligned, 200, 64);
+    }
+
+    void TestReuse() {
+        PlanetKitPoolAllocator pool;
+        void* p1 = pool.Allocate(48);
+        pool.Free(p1, 48);
+        void* p2 = pool.Allocate(48);
+        PLNK_CHECK(p1 == p2);
+        pool.Free(p2, 48);
+    }
+
+    void TestCrossThreadFree() {
+        PlanetKitPoolAllocator pool;
+        std::vector<void*> blocks;
+        for (int i = 0; i < 10000; ++i) {
+            blocks.push_back(pool.Allocate(32));
+        }
+
+        std::thread thread([&]() {
+            for (void* ptr : blocks) {
+                pool.Free(ptr, 32);
+            }
+        });
+        thread.join();
+
+        // The blocks freed remotely come back to the owner once its local list runs dry.
+        for (int i = 0; i < 10000; ++i) {
+            void* ptr = pool.Allocate(32);
+            PLNK_CHECK(ptr != nullptr);
+            blocks[i] = ptr;
+        }
+        for (void* ptr : blocks) {
+            pool.Free(ptr, 32);
+        }
+        pool.Reclaim();
+    }
+};
+
+int main() {
+    TestSizeClassesArePacked();
+    TestAlignment();
+    TestReuse();
+    TestCrossThreadFree();
+    return PlanetKitTest::Finish("PoolAllocatorTest");
+}
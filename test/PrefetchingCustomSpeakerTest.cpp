@@ -0,0 +1,253 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+// Checks the ring sizing, sample continuity and target adaptation of PrefetchingCustomSpeaker.
+
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#include <thread>
+
+#include "PlanetKitPrefetchingCustomSpeaker.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    /**
+     * Plays an increasing 16-bit sample counter.
+     */
+    class CountingSpeakerEvent : public ISpeakerEvent {
+    public:
+        bool WillPlay(SAudioData& sAudioData) override {
+            int16_t* pSamples = reinterpret_cast<int16_t*>(sAudioData.ucBuffer);
+            for (unsigned int i = 0; i < sAudioData.unAudioDataSampleCount; ++i) {
+                pSamples[i] = m_sNext++;
+            }
+            sAudioData.unBufferSize = sAudioData.unAudioDataSampleCount * sizeof(int16_t);
+            return true;
+        }
+
+    private:
+        int16_t m_sNext = 0;
+    };
+
+    /**
+     * Delivers one pull, then blocks the pull thread until released, so that every following output call underruns.
+     */
+    class StallingSpeakerEvent : public ISpeakerEvent {
+    public:
+        bool WillPlay(SAudioData& sAudioData) override {
+            if (m_unCalls++ > 0) {
+                while (m_bReleased.load(std::memory_order_acquire) == false) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            memset(sAudioData.ucBuffer, 0, sAudioData.unAudioDataSampleCount * sizeof(int16_t));
+            sAudioData.unBufferSize = sAudioData.unAudioDataSampleCount * sizeof(int16_t);
+            return true;
+        }
+
+        void Release() {
+            m_bReleased.store(true, std::memory_order_release);
+        }
+
+    private:
+        unsigned int m_unCalls = 0;
+        std::atomic<bool> m_bReleased{ false };
+    };
+
+    class TestSpeaker : public PrefetchingCustomSpeaker {
+    public:
+        explicit TestSpeaker(const SPrefetchingSpeakerConfig& sConfig) : PrefetchingCustomSpeaker(sConfig) {
+        }
+
+        bool IsRunning() override {
+            return true;
+        }
+
+        bool SetVolumeLevel(float fVolume) override {
+            PLNK_UNREFERENCED_PARAMETER(fVolume);
+            return false;
+        }
+
+        float GetVolumeLevel() override {
+            return 0.0f;
+        }
+
+        float GetPeakValue() override {
+            return 0.0f;
+        }
+
+        bool RegisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        bool DeregisterVolumeLevelChangedEvent(AudioVolumeLevelChangedEventPtr pEvent) override {
+            PLNK_UNREFERENCED_PARAMETER(pEvent);
+            return false;
+        }
+
+        AudioDeviceInfoPtr GetDeviceInfo() override {
+            return nullptr;
+        }
+
+        bool PlayFile(const WString& strFilePath, unsigned int unLoop) override {
+            PLNK_UNREFERENCED_PARAMETER(strFilePath);
+            PLNK_UNREFERENCED_PARAMETER(unLoop);
+            return false;
+        }
+
+        bool StopPlay() override {
+            return false;
+        }
+    };
+
+    SAudioData MakeRequest(int16_t* pSamples, unsigned int unSamplingRate, unsigned int unSampleCount) {
+        SAudioData sAudioData = {};
+        sAudioData.unAudioDataSamplingRate = unSamplingRate;
+        sAudioData.unAudioDataSampleCount = unSampleCount;
+        sAudioData.eAudioDataSampleFormat = PLNK_AUDIO_DATA_SAMPLE_TYPE_SHORT16;
+        sAudioData.ucBuffer = reinterpret_cast<unsigned char*>(pSamples);
+        sAudioData.unBufferSize = unSampleCount * sizeof(int16_t);
+        return sAudioData;
+    }
+
+    bool WaitForFill(const PrefetchingCustomSpeaker& speaker, unsigned int unFillMs) {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        SPrefetchingSpeakerStatistics sStatistics = {};
+        for (speaker.GetStatistics(sStatistics); sStatistics.unFillMs < unFillMs; speaker.GetStatistics(sStatistics)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    void TestNoAdaptationWithoutSession() {
+        SPrefetchingSpeakerConfig sConfig;
+        sConfig.unInitialTargetMs = 20;
+        TestSpeaker speaker(sConfig);
+        PLNK_CHECK(speaker.Start());
+
+        int16_t samples[480];
+        for (int i = 0; i < 50; ++i) {
+            SAudioData sAudioData = MakeRequest(samples, 48000, 480);
+            PLNK_CHECK(speaker.PullAudioData(sAudioData));
+            PLNK_CHECK(sAudioData.unBufferSize == sizeof(samples));
+        }
+        speaker.Stop();
+
+        SPrefetchingSpeakerStatistics sStatistics = {};
+        speaker.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullUnderruns == 50);
+        PLNK_CHECK(sStatistics.unTargetMs == 20);
+        PLNK_CHECK(sStatistics.unFillMs == 0);
+    }
+
+    void TestTargetGrowsOnePullPerUnderrun() {
+        SPrefetchingSpeakerConfig sConfig;
+        sConfig.unPullFrameMs = 10;
+        sConfig.unInitialTargetMs = 10;
+        sConfig.unMaxTargetMs = 200;
+        TestSpeaker speaker(sConfig);
+        SharedPtr<StallingSpeakerEvent> pEvent = MakeAutoPtr<StallingSpeakerEvent>();
+        speaker.RegisterSpeakerEvent(pEvent);
+
+        PLNK_CHECK(speaker.Start());
+        PLNK_CHECK(WaitForFill(speaker, 10));
+
+        // The first call plays the prefetched pull. The following ones come on time but find the ring empty.
+        const unsigned int unUnderruns = 4;
+        int16_t samples[480];
+        std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i <= unUnderruns; ++i) {
+            std::this_thread::sleep_until(next);
+            next += std::chrono::milliseconds(10);
+            SAudioData sAudioData = MakeRequest(samples, 48000, 480);
+            PLNK_CHECK(speaker.PullAudioData(sAudioData));
+        }
+
+        SPrefetchingSpeakerStatistics sStatistics = {};
+        speaker.GetStatistics(sStatistics);
+        pEvent->Release();
+        speaker.Stop();
+
+        // One pull plus one pull per underrun. Timing jitter of the calls above may add a few ms.
+        PLNK_CHECK(sStatistics.ullUnderruns == unUnderruns);
+        PLNK_CHECK(sStatistics.unTargetMs + 2 >= 10 * (unUnderruns + 1));
+        PLNK_CHECK(sStatistics.unTargetMs <= 10 * (unUnderruns + 1) + 6);
+    }
+
+    void TestFractionalSamplesPerMs() {
+        // 44.1 kHz has 44.1 samples per ms. A pull of 10 ms must be 441 samples, not 440.
+        SPrefetchingSpeakerConfig sConfig;
+        sConfig.unSamplingRate = 44100;
+        sConfig.unInitialTargetMs = 40;
+        sConfig.unMinTargetMs = 40;
+        sConfig.bAdaptiveTarget = false;
+        TestSpeaker speaker(sConfig);
+        speaker.RegisterSpeakerEvent(MakeAutoPtr<CountingSpeakerEvent>());
+
+        PLNK_CHECK(speaker.Start());
+        PLNK_CHECK(WaitForFill(speaker, 40));
+        speaker.Stop();
+
+        SPrefetchingSpeakerStatistics sStatistics = {};
+        speaker.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.unFillMs == 40);
+
+        // 40 ms is exactly 1764 samples, delivered in pulls of 441.
+        int16_t samples[1764];
+        SAudioData sAudioData = MakeRequest(samples, 44100, 1764);
+        PLNK_CHECK(speaker.PullAudioData(sAudioData));
+        for (int i = 0; i < 1764; ++i) {
+            PLNK_CHECK(samples[i] == i);
+        }
+
+        speaker.GetStatistics(sStatistics);
+        PLNK_CHECK(sStatistics.ullUnderruns == 0);
+        PLNK_CHECK(sStatistics.unFillMs == 0);
+    }
+
+    void TestRejectsMismatchedFormat() {
+        TestSpeaker speaker((SPrefetchingSpeakerConfig()));
+        int16_t samples[441];
+        SAudioData sAudioData = MakeRequest(samples, 44100, 441);
+        PLNK_CHECK(speaker.PullAudioData(sAudioData) == false);
+
+        sAudioData = MakeRequest(samples, 48000, 441);
+        sAudioData.unBufferSize = 100;
+        PLNK_CHECK(speaker.PullAudioData(sAudioData) == false);
+    }
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+    TestNoAdaptationWithoutSession();
+    TestTargetGrowsOnePullPerUnderrun();
+    TestFractionalSamplesPerMs();
+    TestRejectsMismatchedFormat();
+
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == PlanetKitHostMemory::GetFreeCount() - ullFrees);
+
+    return PlanetKitTest::Finish("PrefetchingCustomSpeakerTest");
+}
@@ -0,0 +1,131 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include "PlanetKit.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    struct SBase {
+        virtual ~SBase() {}
+    };
+
+    struct SDerived : public SBase {
+        explicit SDerived(int* pDestroyed) : m_pDestroyed(pDestroyed) {}
+
+        ~SDerived() {
+            ++*m_pDestroyed;
+        }
+
+        int* m_pDestroyed;
+    };
+
+    struct SMoveOnly {
+        explicit SMoveOnly(int nValue) : m_nValue(nValue) {}
+        SMoveOnly(const SMoveOnly&) = delete;
+        SMoveOnly(SMoveOnly&& other) : m_nValue(other.m_nValue) {
+            other.m_nValue = 0;
+        }
+
+        int m_nValue;
+    };
+
+    struct SHolder {
+        explicit SHolder(SMoveOnly&& value) : m_value(std::move(value)) {}
+
+        SMoveOnly m_value;
+    };
+
+    // Layout of ControlBlock<T> in the SDK binary.
+    struct SBaselineControlBlock {
+        virtual ~SBaselineControlBlock() {}
+
+        void* ptr_;
+        LONG ref_count_;
+    };
+
+    static_assert(sizeof(ControlBlock<SBase>) == sizeof(SBaselineControlBlock), "ControlBlock layout changed");
+    static_assert(sizeof(SharedPtr<SBase>) == sizeof(void*), "SharedPtr layout changed");
+
+    void TestMakeAutoPtr() {
+        int nDestroyed = 0;
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+        {
+            // SharedPtr blocks are shared with the SDK, so the object and the block are allocated separately as before.
+            SharedPtr<SDerived> ptr = MakeAutoPtr<SDerived>(&nDestroyed);
+            PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == 2);
+
+            SharedPtr<SBase> pBase = ptr;
+            PLNK_CHECK(pBase.as<SDerived>() == ptr);
+        }
+        PLNK_CHECK(nDestroyed == 1);
+        PLNK_CHECK(PlanetKitHostMemory::GetFreeCount() - ullFrees == 2);
+
+        SharedPtr<SHolder> pHolder = MakeAutoPtr<SHolder>(SMoveOnly(7));
+        PLNK_CHECK(pHolder->m_value.m_nValue == 7);
+    }
+
+    void TestMakeInplaceAutoPtr() {
+        int nDestroyed = 0;
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+        {
+            InplaceSharedPtr<SDerived> ptr = MakeInplaceAutoPtr<SDerived>(&nDestroyed);
+            PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == 1);
+
+            InplaceSharedPtr<SBase> pBase = ptr;
+            InplaceSharedPtr<SDerived> pDerived = pBase.as<SDerived>();
+            PLNK_CHECK(pDerived == ptr);
+            PLNK_CHECK(pDerived.hasValue());
+
+            ptr = nullptr;
+            pDerived = nullptr;
+            PLNK_CHECK(nDestroyed == 0);
+        }
+        PLNK_CHECK(nDestroyed == 1);
+        PLNK_CHECK(PlanetKitHostMemory::GetFreeCount() - ullFrees == 1);
+
+        InplaceSharedPtr<SHolder> pHolder = MakeInplaceAutoPtr<SHolder>(SMoveOnly(9));
+        PLNK_CHECK(pHolder->m_value.m_nValue == 9);
+    }
+
+    void TestMakeLocalAutoPtr() {
+        int nDestroyed = 0;
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        {
+            LocalSharedPtr<SDerived> ptr = MakeLocalAutoPtr<SDerived>(&nDestroyed);
+            LocalSharedPtr<SBase> pCopy = ptr;
+            PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == 1);
+
+            WeakPtr<SBase, SingleThreadRefCountPolicy> pWeak = pCopy;
+            ptr = nullptr;
+            PLNK_CHECK(pWeak.expired() == false);
+            pCopy = nullptr;
+            PLNK_CHECK(pWeak.expired());
+            PLNK_CHECK(pWeak.lock().hasValue() == false);
+        }
+        PLNK_CHECK(nDestroyed == 1);
+    }
+};
+
+int main() {
+    TestMakeAutoPtr();
+    TestMakeInplaceAutoPtr();
+    TestMakeLocalAutoPtr();
+    return PlanetKitTest::Finish("SharedPtrTest");
+}
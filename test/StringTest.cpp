@@ -0,0 +1,122 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+#include <utility>
+
+#include "PlanetKit.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    // Members of String and WString as the SDK binary sees them.
+    struct BaselineStringLayout {
+        void* pVtable;
+        void* m_pData;
+        size_t m_nSize;
+    };
+
+    void TestLayout() {
+        PLNK_CHECK(sizeof(String) == sizeof(BaselineStringLayout));
+        PLNK_CHECK(sizeof(WString) == sizeof(BaselineStringLayout));
+
+        WString strName(L"subgroup");
+        const BaselineStringLayout* pLayout = reinterpret_cast<const BaselineStringLayout*>(&strName);
+        PLNK_CHECK(pLayout->m_pData == strName.c_str());
+        PLNK_CHECK(pLayout->m_nSize == 8);
+    }
+
+    void TestBuilder() {
+        WStringBuilder builder;
+        uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+        for (int i = 0; i < 1000; ++i) {
+            builder.Append(L"piece-").Append(i).Append(L',');
+        }
+        // Doubling needs only a logarithmic number of reallocations.
+        PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations < 32);
+        PLNK_CHECK(wcsncmp(builder.c_str(), L"piece-0,piece-1,", 16) == 0);
+
+        builder.Append(builder.c_str(), 8);
+        WString strResult = builder.TakeString();
+        PLNK_CHECK(strResult.Substring((unsigned int)strResult.Size() - 8) == L"piece-0,");
+        PLNK_CHECK(builder.Size() == 0);
+
+        builder.Append("utf-8 ").Append(-42);
+        PLNK_CHECK(builder.GetString() == L"utf-8 -42");
+        builder.Clear();
+        PLNK_CHECK(builder.Size() == 0 && builder.GetString() == L"");
+    }
+
+    void TestEmptyString() {
+        // An empty String holds no buffer, as in the SDK binary.
+        String strEmpty;
+        PLNK_CHECK(strEmpty.Size() == 0);
+        PLNK_CHECK(strcmp(strEmpty.c_str(), "") == 0);
+        PLNK_CHECK(strEmpty == "");
+        PLNK_CHECK(strEmpty == String());
+
+        String strValue("peer");
+        strValue = "";
+        PLNK_CHECK(strValue.Size() == 0);
+        PLNK_CHECK(strValue == strEmpty);
+
+        strEmpty.Append("room");
+        PLNK_CHECK(strEmpty == "room");
+    }
+
+    void TestMovedFrom() {
+        WString strName(L"subgroup-name");
+        WString strMoved(std::move(strName));
+        PLNK_CHECK(strMoved == L"subgroup-name");
+        PLNK_CHECK(strName.Size() == 0);
+        PLNK_CHECK(wcscmp(strName.c_str(), L"") == 0);
+        PLNK_CHECK(strName == WString());
+
+        WString strCopy(strName);
+        PLNK_CHECK(strCopy.Size() == 0 && strCopy.c_str()[0] == L'\0');
+
+        strName += L"again";
+        PLNK_CHECK(strName == L"again");
+
+        String strNarrow("peer");
+        String strNarrowMoved(std::move(strNarrow));
+        PLNK_CHECK(strNarrowMoved == "peer");
+        PLNK_CHECK(strNarrow.Size() == 0);
+    }
+
+    void TestSelfAppend() {
+        WString strName(L"ab");
+        for (int i = 0; i < 5; ++i) {
+            strName += strName;
+        }
+        PLNK_CHECK(strName.Size() == 64);
+        PLNK_CHECK(strName.Substring(62) == L"ab");
+
+        String strNarrow("ab");
+        strNarrow.Append(strNarrow.c_str());
+        PLNK_CHECK(strNarrow == "abab");
+    }
+};
+
+int main() {
+    TestLayout();
+    TestBuilder();
+    TestEmptyString();
+    TestMovedFrom();
+    TestSelfAppend();
+    return PlanetKitTest::Finish("StringTest");
+}
@@ -0,0 +1,57 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+
+#include "PlanetKitSubgroupAtom.hpp"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    void TestMainRoom() {
+        SubgroupAtom atomMain;
+        PLNK_CHECK(atomMain.IsMainRoom());
+        PLNK_CHECK(atomMain.GetName().HasValue() == false);
+        PLNK_CHECK(SubgroupAtom::Intern(WStringOptional(NullOptional)) == atomMain);
+        PLNK_CHECK(SubgroupAtom::Intern(static_cast<const wchar_t*>(nullptr)) == atomMain);
+    }
+
+    void TestEmptyName() {
+        // An empty name is not the main room.
+        SubgroupAtom atomEmpty = SubgroupAtom::Intern(WString());
+        PLNK_CHECK(atomEmpty.IsMainRoom() == false);
+        PLNK_CHECK(atomEmpty != SubgroupAtom());
+        PLNK_CHECK(atomEmpty.GetName().HasValue());
+        PLNK_CHECK(atomEmpty.GetName()->Size() == 0);
+        PLNK_CHECK(SubgroupAtom::Intern(L"") == atomEmpty);
+        PLNK_CHECK(SubgroupAtom::Intern(WStringOptional(WString())) == atomEmpty);
+    }
+
+    void TestInterning() {
+        SubgroupAtom atomA = SubgroupAtom::Intern(L"subgroup-a");
+        SubgroupAtom atomB = SubgroupAtom::Intern(WString(L"subgroup-b"));
+        PLNK_CHECK(atomA != atomB);
+        PLNK_CHECK(SubgroupAtom::Intern(WString(L"subgroup-a")) == atomA);
+        PLNK_CHECK(atomA.GetHash() == SubgroupAtom::Intern(L"subgroup-a").GetHash());
+        PLNK_CHECK(*atomA.GetName() == L"subgroup-a");
+    }
+};
+
+int main() {
+    TestMainRoom();
+    TestEmptyName();
+    TestInterning();
+    return PlanetKitTest::Finish("SubgroupAtomTest");
+}
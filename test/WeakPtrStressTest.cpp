@@ -0,0 +1,141 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Churns 100k register/deregister cycles across threads. Each cycle creates a session that owns its event handler,
+// while the handler refers back to the session through a WeakPtr. A dispatcher thread keeps locking and calling
+// whatever handler is registered. Every session must be destroyed once it is deregistered, and every allocation freed.
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PlanetKit.h"
+#include "PlanetKitHostMemory.h"
+#include "PlanetKitTest.h"
+
+using namespace PlanetKit;
+
+namespace {
+    enum {
+        CYCLES = 100000,
+        THREADS = 4
+    };
+
+    std::atomic<int> g_nLiveSessions(0);
+    std::atomic<int> g_nLiveHandlers(0);
+
+    struct SSession;
+
+    struct SHandler {
+        explicit SHandler(const InplaceSharedPtr<SSession>& pSession) : m_pSession(pSession) {
+            ++g_nLiveHandlers;
+        }
+
+        ~SHandler() {
+            --g_nLiveHandlers;
+        }
+
+        void OnEvent();
+
+        WeakPtr<SSession> m_pSession;
+    };
+
+    struct SSession {
+        SSession() {
+            ++g_nLiveSessions;
+        }
+
+        ~SSession() {
+            --g_nLiveSessions;
+        }
+
+        InplaceSharedPtr<SHandler> m_pHandler;
+        std::atomic<int> m_nEvents{ 0 };
+    };
+
+    void SHandler::OnEvent() {
+        InplaceSharedPtr<SSession> pSession = m_pSession.lock();
+        if (pSession.hasValue()) {
+            ++pSession->m_nEvents;
+        }
+    }
+
+    // The registry only keeps weak references, like an SDK slot that must not extend the session lifetime.
+    std::mutex g_mutex;
+    WeakPtr<SHandler> g_pRegistered;
+
+    void Register(const InplaceSharedPtr<SHandler>& pHandler) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_pRegistered = pHandler;
+    }
+
+    void Deregister() {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_pRegistered = nullptr;
+    }
+
+    WeakPtr<SHandler> GetRegistered() {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        return g_pRegistered;
+    }
+};
+
+int main() {
+    uint64_t ullAllocations = PlanetKitHostMemory::GetAllocationCount();
+    uint64_t ullFrees = PlanetKitHostMemory::GetFreeCount();
+
+    std::atomic<bool> bStop(false);
+    std::atomic<uint64_t> ullDispatched(0);
+    std::thread dispatcher([&]() {
+        while (bStop.load() == false) {
+            WeakPtr<SHandler> pWeak = GetRegistered();
+            InplaceSharedPtr<SHandler> pHandler = pWeak.lock();
+            if (pHandler.hasValue()) {
+                pHandler->OnEvent();
+                ++ullDispatched;
+            }
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([]() {
+            for (int i = 0; i < CYCLES / THREADS; ++i) {
+                InplaceSharedPtr<SSession> pSession = MakeInplaceAutoPtr<SSession>();
+                pSession->m_pHandler = MakeInplaceAutoPtr<SHandler>(pSession);
+
+                Register(pSession->m_pHandler);
+                pSession->m_pHandler->OnEvent();
+                Deregister();
+            }
+        });
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    bStop = true;
+    dispatcher.join();
+
+    PLNK_CHECK(GetRegistered().expired());
+    PLNK_CHECK(g_nLiveSessions.load() == 0);
+    PLNK_CHECK(g_nLiveHandlers.load() == 0);
+    PLNK_CHECK(PlanetKitHostMemory::GetAllocationCount() - ullAllocations == 2 * CYCLES);
+    PLNK_CHECK(PlanetKitHostMemory::GetFreeCount() - ullFrees == 2 * CYCLES);
+
+    printf("dispatched %llu events\n", (unsigned long long)ullDispatched.load());
+    return PlanetKitTest::Finish("WeakPtrStressTest");
+}
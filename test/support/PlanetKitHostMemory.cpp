@@ -0,0 +1,68 @@
+// Copyright 2025 LINE Plus Corporation
+//
+// LINE Plus Corporation licenses this file to you under the Apache License,
+// version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at:
+//
+//   https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+// Host implementation of the PlanetKitMemory functions that the SDK binary exports, for tests and benchmarks built
+// without it. Every call is counted so that tests can check allocation behaviour.
+
+#include <stdlib.h>
+#include <atomic>
+
+#include "PlanetKitMemory.h"
+#include "PlanetKitHostMemory.h"
+
+namespace {
+    std::atomic<uint64_t> g_ullAllocations(0);
+    std::atomic<uint64_t> g_ullFrees(0);
+
+    void* Allocate(size_t size) {
+        g_ullAllocations.fetch_add(1, std::memory_order_relaxed);
+        return malloc(size ? size : 1);
+    }
+
+    void Free(void* ptr) {
+        if (ptr) {
+            g_ullFrees.fetch_add(1, std::memory_order_relaxed);
+            free(ptr);
+        }
+    }
+};
+
+namespace PlanetKit {
+    void* PlanetKitMemory::AllocateMemory(size_t size) {
+        return Allocate(size);
+    }
+
+    void PlanetKitMemory::FreeMemory(void* ptr) {
+        Free(ptr);
+    }
+
+    void* PlanetKitMemory::AllocateArrayMemory(size_t size) {
+        return Allocate(size);
+    }
+
+    void PlanetKitMemory::FreeArrayMemory(void* ptr) {
+        Free(ptr);
+    }
+};
+
+namespace PlanetKitHostMemory {
+    uint64_t GetAllocationCount() {
+        return g_ullAllocations.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetFreeCount() {
+        return g_ullFrees.load(std::memory_order_relaxed);
+    }
+};